@@ -0,0 +1,36 @@
+#pragma once
+
+#include <chrono>
+#include <cstdio>
+#include <string>
+
+namespace bench {
+// keeps the optimizer from dropping the measured work
+static volatile size_t sink = 0;
+
+// runs `fn` until at least `minSeconds` have passed and returns
+// the average time of a single run in seconds
+template <typename Fn> double measure(Fn fn, double minSeconds = 0.25)
+{
+  using clock = std::chrono::steady_clock;
+
+  size_t runs = 0;
+  const auto start = clock::now();
+  double elapsed = 0;
+
+  do
+  {
+    fn();
+    ++runs;
+    elapsed = std::chrono::duration<double>(clock::now() - start).count();
+  } while (elapsed < minSeconds);
+
+  return elapsed / static_cast<double>(runs);
+}
+
+inline void report(const std::string& name, const size_t bytes, const double seconds)
+{
+  std::printf("%-32s %10.1f MB/s\n", name.c_str(),
+              static_cast<double>(bytes) / seconds / (1024.0 * 1024.0));
+}
+} // namespace bench
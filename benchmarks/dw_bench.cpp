@@ -0,0 +1,76 @@
+#include "../include/tabular/string_utils.h"
+#include "bench.h"
+
+using namespace tabular;
+
+// the byte by byte implementation `dw` used before the ascii fast path,
+// kept here as the reference point
+static size_t scalarDw(const char* str)
+{
+  using namespace string_utils;
+
+  size_t width = 0;
+  const char* ptr = str;
+
+  while (*ptr)
+  {
+    if (*ptr == '\x1b')
+    {
+      ++ptr;
+      while (*ptr && isAscii(*ptr) && !isAlpha(*ptr))
+        ++ptr;
+
+      if (*ptr && isAlpha(*ptr)) ++ptr;
+      continue;
+    }
+
+    uint32_t wc;
+    int consumed = 1;
+    if (utf8twc(ptr, wc, consumed))
+    {
+      width += wcwidth(wc);
+      ptr += consumed;
+    }
+    else
+    {
+      ++width;
+      ++ptr;
+    }
+  }
+
+  return width;
+}
+
+static std::string repeat(const std::string& str, const size_t bytes)
+{
+  std::string result;
+  result.reserve(bytes + str.size());
+
+  while (result.size() < bytes)
+    result += str;
+
+  return result;
+}
+
+static void run(const std::string& name, const std::string& input)
+{
+  const double before = bench::measure([&] { bench::sink = scalarDw(input.c_str()); });
+  const double after =
+      bench::measure([&] { bench::sink = string_utils::dw(input.c_str()); });
+
+  bench::report(name + " (scalar)", input.size(), before);
+  bench::report(name + " (dw)", input.size(), after);
+}
+
+int main()
+{
+  const size_t bytes = 1 << 20;
+
+  run("ascii", repeat("The quick brown fox jumps over the lazy dog. ", bytes));
+  run("ascii words", repeat("OK ", bytes));
+  run("styled", repeat("\x1b[31mERROR\x1b[0m request took 12.5 ms ", bytes));
+  run("latin", repeat("naïve café über ", bytes));
+  run("cjk", repeat("漢字テスト ", bytes));
+
+  return 0;
+}
@@ -0,0 +1,113 @@
+#include "../include/tabular/column_store.h"
+#include "../include/tabular/table.h"
+#include "../include/tabular/table_view.h"
+#include "bench.h"
+
+#include <thread>
+
+using namespace tabular;
+
+// a 10000x5 table of short values, the way most tables look like
+static Table makeTable()
+{
+  Table table;
+  table.config().width(100);
+
+  for (size_t i = 0; i < 10000; ++i)
+  {
+    const std::string id = std::to_string(i);
+    table.addRow({id, "OK", "12.5 ms", "service-" + id, "a longer description"});
+  }
+
+  return table;
+}
+
+int main()
+{
+  Table table = makeTable();
+  const size_t bytes = table.str().size();
+
+  // every cell is wrapped again
+  bench::report("first render", bytes, bench::measure([&] {
+    Table fresh = makeTable();
+    bench::sink = fresh.str().size();
+  }));
+
+  // nothing changed, the cached rows are concatenated
+  bench::report("render after touch", bytes, bench::measure([&] {
+    table.border(table.border()); // invalidate the table's output
+    bench::sink = table.str().size();
+  }));
+
+  // streamed row by row without building the table's string
+  bench::report("streaming render", bytes, bench::measure([&] {
+    table.border(table.border()); // invalidate the table's output
+    size_t written = 0;
+    table.render([&](const char*, size_t len) { written += len; });
+    bench::sink = written;
+  }));
+
+  // every cell is wrapped again, the rows are shared between the threads
+  const size_t threads = (std::max)(std::thread::hardware_concurrency(), 2u);
+  bench::report("parallel first render", bytes, bench::measure([&] {
+    Table fresh = makeTable();
+    fresh.config().threads(threads);
+    bench::sink = fresh.str().size();
+  }));
+
+  // a single cell changed
+  size_t i = 0;
+  bench::report("render after edit", bytes, bench::measure([&] {
+    ++i;
+    table[i % 10000][1].content(i % 2 ? "FAIL" : "OK");
+    bench::sink = table.str().size();
+  }));
+
+  // a page of a pager, only its rows are rendered
+  size_t page = 0;
+  bench::report("page render", table.str(0, 50).size(), bench::measure([&] {
+    const size_t first = (page++ * 50) % 10000;
+    bench::sink = table.str(first, first + 50).size();
+  }));
+
+  // the rows in another order, they reuse their cached output
+  TableView view(table);
+  bool descending = false;
+  bench::report("sorted view render", bytes, bench::measure([&] {
+    descending = !descending;
+    view.sort([&](const Row& a, const Row& b) {
+      return descending ? b[0].content() < a[0].content() : a[0].content() < b[0].content();
+    });
+
+    size_t written = 0;
+    view.render([&](const char*, size_t len) { written += len; });
+    bench::sink = written;
+  }));
+
+  // the keys are extracted once, then the rows are moved to their places
+  bool reversed = false;
+  bench::report("numeric sort", bytes, bench::measure([&] {
+    reversed = !reversed;
+    table.sort({SortKey::Numeric(0).descending(reversed)});
+    bench::sink = table.rows().size();
+  }));
+
+  // the same cells stored column by column, without an object per cell
+  ColumnStore store(5);
+  store.reserve(10000, 8);
+  for (size_t i = 0; i < 10000; ++i)
+  {
+    const std::string id = std::to_string(i);
+    store.addRow({id, "OK", "12.5 ms", "service-" + id, "a longer description"});
+  }
+
+  VirtualTable virt(store);
+  virt.config().width(100);
+  bench::report("column store render", bytes, bench::measure([&] {
+    size_t written = 0;
+    virt.render([&](const char*, size_t len) { written += len; });
+    bench::sink = written;
+  }));
+
+  return 0;
+}
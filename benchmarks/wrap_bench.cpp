@@ -0,0 +1,37 @@
+#include "../include/tabular/column.h"
+#include "bench.h"
+
+using namespace tabular;
+
+// wrapping must stay linear in the content length, both for a single token
+// wider than the column and for many short words, the MB/s should not drop
+// as the size grows
+static void run(const std::string& name, const std::string& unit, const size_t width)
+{
+  for (size_t bytes = 64 * 1024; bytes <= 4 * 1024 * 1024; bytes *= 4)
+  {
+    std::string token;
+    token.reserve(bytes + unit.size());
+    while (token.size() < bytes)
+      token += unit;
+
+    Column column(token);
+    column.config().width(width);
+
+    const double seconds = bench::measure([&] {
+      column.config().width(width); // invalidate the cache
+      bench::sink = column.lines().size();
+    });
+
+    bench::report(name + " " + std::to_string(bytes / 1024) + "KB", token.size(),
+                  seconds);
+  }
+}
+
+int main()
+{
+  run("base64", "QUJDREVGR0hJSktMTU5PUFFSU1RVVldYWVo=", 20);
+  run("cjk", "漢字テスト", 20);
+  run("words", "lorem ipsum \x1b[1mdolor\x1b[0m sit amet ", 20);
+  return 0;
+}
@@ -32,22 +32,16 @@ using namespace tabular;
 
 void adjustWidth(Table& table)
 {
-  // the first column
-  for (size_t i = 0; i < 6; ++i) table[i][0].config().width(5);
+  // the width of each column in every row, instead of setting it cell by cell:
+  // 5 + 20 + 16 + 10 + 13 = 64
+  table.config().columns({
+    ColumnWidth::Fixed(5),
+    ColumnWidth::Fixed(20),
+    ColumnWidth::Fixed(16),
+    ColumnWidth::Fixed(10),
+    ColumnWidth::Fixed(13),
+  });
 
-  // the second column
-  for (size_t i = 0; i < 6; ++i) table[i][1].config().width(20);
-
-  // the third column
-  for (size_t i = 0; i < 6; ++i) table[i][2].config().width(16);
-
-  // the fourth column
-  for (size_t i = 0; i < 6; ++i) table[i][3].config().width(10);
-
-  // the fifth column
-  for (size_t i = 0; i < 6; ++i) table[i][4].config().width(13);
-
-  // the total width set: 5 + 20 + 16 + 10 + 13 = 64
   // `width - (columns.size() + 1)`: 70 - (5 + 1) = 64
   // so the width will get applied without any problems
   table.config().width(70);
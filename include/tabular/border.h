@@ -1,8 +1,10 @@
 #pragma once
 
+#include <algorithm>
 #include <string>
 #include "color.h"
 #include "global.h"
+#include "string_utils.h"
 
 namespace tabular {
 // clang-format off
@@ -13,38 +15,34 @@ public:
     Part(const uint32_t glyph)
       : glyph_(glyph), dirty_(true)
     {
+      gen_.bump();
     }
 
     Part& glyph(const uint32_t glyph)
     {
-      glyph_ = glyph;
-      dirty_ = true;
+      set(glyph_, glyph);
       return *this;
     }
 
     Part& fg(const Color color)
     {
-      fg_ = static_cast<uint32_t>(color);
-      dirty_ = true;
+      set(fg_, static_cast<uint32_t>(color));
       return *this;
     }
     Part& fg(const Rgb rgb)
     {
-      fg_ = rgb.toHex() | (1u << 24);
-      dirty_ = true;
+      set(fg_, rgb.toHex() | (1u << 24));
       return *this;
     }
 
     Part& bg(const Color color)
     {
-      bg_ = static_cast<uint32_t>(color);
-      dirty_ = true;
+      set(bg_, static_cast<uint32_t>(color));
       return *this;
     }
     Part& bg(const Rgb rgb)
     {
-      bg_ = rgb.toHex() | (1u << 24);
-      dirty_ = true;
+      set(bg_, rgb.toHex() | (1u << 24));
       return *this;
     }
 
@@ -63,24 +61,44 @@ public:
 
     Part& clrFg()
     {
-      fg_ = 0;
-      dirty_ = true;
+      set(fg_, 0u);
       return *this;
     }
     Part& clrBg()
     {
-      bg_ = 0;
-      dirty_ = true;
+      set(bg_, 0u);
       return *this;
     }
     Part& clr()
     {
-      fg_ = 0;
-      bg_ = 0;
-      dirty_ = true;
+      set(fg_, 0u);
+      set(bg_, 0u);
       return *this;
     }
 
+    bool operator==(const Part& other) const
+    {
+      return glyph_ == other.glyph_ && fg_ == other.fg_ && bg_ == other.bg_;
+    }
+    bool operator!=(const Part& other) const { return !(*this == other); }
+
+    // changes whenever the part changes, see `detail::Generation`
+    uint64_t generation() const { return gen_; }
+
+    // appends `count` glyphs, the colors are set once for all of them
+    void fill(std::string& out, const size_t count) const
+    {
+      if (count == 0) return;
+
+      const std::string& str = this->str();
+      const size_t suffix = str.size() - sgrSize_ - glyphSize_;
+
+      out.reserve(out.size() + str.size() + glyphSize_ * (count - 1));
+      out.append(str, 0, sgrSize_);
+      string_utils::repeat(out, str.data() + sgrSize_, glyphSize_, count);
+      out.append(str, str.size() - suffix, suffix);
+    }
+
     explicit operator const std::string&() const { return str(); }
     const std::string& str() const
     {
@@ -98,9 +116,23 @@ public:
     uint32_t fg_ = 0; // fg color
     uint32_t bg_ = 0; // bg color
 
-    // cache
+    // the last change
+    detail::Generation gen_;
+
+    // cache, with the sizes of the escape sequence and the glyph in it
     mutable bool dirty_ = false;
     mutable std::string str_;
+    mutable size_t sgrSize_ = 0;
+    mutable size_t glyphSize_ = 0;
+
+    void set(uint32_t& field, const uint32_t value)
+    {
+      if (field == value) return;
+
+      field = value;
+      gen_.bump();
+      dirty_ = true;
+    }
 
     std::string genStr() const
     {
@@ -138,7 +170,7 @@ public:
       else if (bg.isRgb())
       {
         Rgb rgb = bg.rgb();
-        if (buffer.empty()) buffer.append("\x1b[48;2;");
+        buffer.append(buffer.empty() ? "\x1b[48;2;" : "48;2;");
         buffer.append(std::to_string(rgb.r));
         buffer.push_back(';');
         buffer.append(std::to_string(rgb.g));
@@ -147,7 +179,12 @@ public:
         buffer.push_back(';');
       }
 
+      // terminate the sequence
+      if (!buffer.empty()) buffer.back() = 'm';
+
       const std::string glyph = glyphToStr();
+      sgrSize_ = buffer.size();
+      glyphSize_ = glyph.size();
       buffer.append(glyph);
 
       if (buffer.length() - glyph.length() > 0)
@@ -201,6 +238,22 @@ public:
   Part& connectorTop() { return connectorTop_; }
   Part& connectorBottom() { return connectorBottom_; }
 
+  // changes whenever one of the parts changes
+  uint64_t generation() const
+  {
+    const Part* parts[] = {&horizontal_, &vertical_, &cornerTopLeft_,
+                           &cornerTopRight_, &cornerBottomLeft_,
+                           &cornerBottomRight_, &intersection_,
+                           &connectorLeft_, &connectorRight_, &connectorTop_,
+                           &connectorBottom_};
+
+    uint64_t generation = 0;
+    for (const Part* part : parts)
+      generation = (std::max)(generation, part->generation());
+
+    return generation;
+  }
+
   const Part& horizontal() const { return horizontal_; }
   const Part& vertical() const { return vertical_; }
   const Part& cornerTopLeft() const { return cornerTopLeft_; }
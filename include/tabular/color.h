@@ -46,11 +46,13 @@ namespace detail {
       : value_(value) {}
 
     bool isSet() { return value_ != 0; }
-    bool isColor() { return isSet() && (value_ & (1u << 24)) == 0; }
+    bool isColor() { return isSet() && (value_ & (3u << 24)) == 0; }
     bool isRgb() { return isSet() && (value_ & (1u << 24)) != 0; }
+    bool isPalette() { return isSet() && (value_ & (1u << 25)) != 0; }
 
     Color color() { return static_cast<Color>(value_ & 0xFFFFFF); }
     Rgb rgb() { return {value_ & 0xFFFFFF}; }
+    uint8_t palette() { return static_cast<uint8_t>(value_ & 0xFF); }
 
     private:
     uint32_t value_;
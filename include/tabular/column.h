@@ -4,6 +4,7 @@
 #include "global.h"
 #include "string_utils.h"
 
+#include <ostream>
 #include <vector>
 
 namespace tabular {
@@ -12,64 +13,183 @@ struct Str {
   std::string str;
   size_t dw;
 };
+
+// a piece of the column's content, it refers to the content instead of
+// copying it, so the wrapper walks the content without any allocation
+struct Token {
+  enum class Kind : uint8_t {
+    Word,    // visible characters
+    Space,   // ' '
+    Newline, // '\n'
+    Escape,  // SGR escape sequence ("\x1b[...m")
+    Reset,   // "\x1b[0m"
+    Ignored, // other space characters and escape sequences
+  };
+
+  size_t offset;
+  size_t length;
+  size_t dw;
+  Kind kind;
+};
+
+// what the content of a column is made of, computed once per content change
+// so the wrapper and the layout don't have to measure the content again
+struct ContentInfo {
+  bool ascii = true;        // only printable ascii and space characters
+  bool hasEscapes = false;  // escape sequences ("\x1b[...")
+  bool hasNewlines = false; // '\n'
+  bool hasSpaces = false;   // space characters other than ' ' and '\n'
+
+  size_t dw = 0;           // the display width of the whole content
+  size_t longestLine = 0;  // the display width of the widest line
+  size_t longestToken = 0; // the display width of the widest word
+};
+
+// the graphic rendition set by the SGR escape sequences ("\x1b[...m") of the
+// content, colors are encoded the same way `Column::Style` does, and 256
+// colors palette indexes are marked with the 26th bit
+struct Sgr {
+  // the background was explicitly reset ("\x1b[49m"), it must be restored
+  // because the column's base color is applied before the line's content
+  constexpr static uint32_t defaultBg = 1u << 26;
+
+  uint32_t fg = 0;
+  uint32_t bg = 0;
+  uint16_t attrs = 0;
+
+  bool empty() const { return fg == 0 && bg == 0 && attrs == 0; }
+  void reset()
+  {
+    fg = 0;
+    bg = 0;
+    attrs = 0;
+  }
+
+  // apply the parameters of an SGR escape sequence to the current state
+  // NOTE: parameters that aren't colors or `Attr`s are ignored
+  void apply(const char* esc, const size_t len)
+  {
+    if (len < 3 || esc[1] != '[') return;
+
+    size_t i = 2;
+    const size_t end = len - 1; // the final 'm'
+
+    // read the next parameter, an empty one is 0
+    auto next = [&]() -> uint32_t {
+      uint32_t value = 0;
+      for (; i < end && esc[i] != ';'; ++i)
+      {
+        if (esc[i] >= '0' && esc[i] <= '9')
+          value = value * 10 + static_cast<uint32_t>(esc[i] - '0');
+      }
+      ++i; // skip ';'
+      return value;
+    };
+
+    // 38;5;n / 48;5;n and 38;2;r;g;b / 48;2;r;g;b
+    auto extended = [&]() -> uint32_t {
+      const uint32_t mode = next();
+      if (mode == 5) return (next() & 0xFF) | (1u << 25);
+      if (mode != 2) return 0;
+
+      const uint32_t r = next() & 0xFF;
+      const uint32_t g = next() & 0xFF;
+      const uint32_t b = next() & 0xFF;
+      return ((r << 16) | (g << 8) | b) | (1u << 24);
+    };
+
+    auto set = [&](Attr attr) { attrs |= static_cast<uint16_t>(attr); };
+    auto clr = [&](Attr attr) {
+      attrs &= static_cast<uint16_t>(~static_cast<uint16_t>(attr));
+    };
+
+    while (i <= end)
+    {
+      const uint32_t code = next();
+
+      if ((code >= 30 && code <= 37) || (code >= 90 && code <= 97)) fg = code;
+      else if ((code >= 40 && code <= 47) || (code >= 100 && code <= 107))
+        bg = code - 10; // stored as the foreground color, like `Column::Style`
+      else
+      {
+        switch (code)
+        {
+        case 0: reset(); break;
+        case 1: set(Attr::Bold); break;
+        case 2: set(Attr::Dim); break;
+        case 3: set(Attr::Italic); break;
+        case 4: set(Attr::Underline); break;
+        case 5: set(Attr::Blink); break;
+        case 6: set(Attr::Flink); break;
+        case 7: set(Attr::Reverse); break;
+        case 8: set(Attr::Concealed); break;
+        case 9: set(Attr::Crossed); break;
+        case 21: set(Attr::Dunderline); break;
+        case 22: clr(Attr::Bold); clr(Attr::Dim); break;
+        case 23: clr(Attr::Italic); break;
+        case 24: clr(Attr::Underline); clr(Attr::Dunderline); break;
+        case 25: clr(Attr::Blink); clr(Attr::Flink); break;
+        case 27: clr(Attr::Reverse); break;
+        case 28: clr(Attr::Concealed); break;
+        case 29: clr(Attr::Crossed); break;
+        case 38: fg = extended(); break;
+        case 39: fg = 0; break;
+        case 48: bg = extended(); break;
+        case 49: bg = defaultBg; break;
+        default: break;
+        }
+      }
+    }
+  }
+};
 } // namespace detail
 // clang-format off
 class Column {
 public:
   class Style {
   public:
-    explicit Style(bool& dirty_) : dirty_(dirty_)
-    {
-    }
-
     Style& fg(Color color)
     {
-      fg_ = static_cast<uint32_t>(color);
-      dirty_ = true;
+      detail::assign(fg_, static_cast<uint32_t>(color), gen_);
       return *this;
     }
     Style& bg(Color color)
     {
-      bg_ = static_cast<uint32_t>(color);
-      dirty_ = true;
+      detail::assign(bg_, static_cast<uint32_t>(color), gen_);
       return *this;
     }
     Style& base(Color color)
     {
-      base_ = static_cast<uint32_t>(color);
-      dirty_ = true;
+      detail::assign(base_, static_cast<uint32_t>(color), gen_);
       return *this;
     }
 
     Style& fg(const Rgb rgb)
     {
-      fg_ = rgb.toHex() | (1u << 24);
-      dirty_ = true;
+      detail::assign(fg_, rgb.toHex() | (1u << 24), gen_);
       return *this;
     }
     Style& bg(const Rgb rgb)
     {
-      bg_ = rgb.toHex() | (1u << 24);
-      dirty_ = true;
+      detail::assign(bg_, rgb.toHex() | (1u << 24), gen_);
       return *this;
     }
     Style& base(const Rgb rgb)
     {
-      base_ = rgb.toHex() | (1u << 24);
-      dirty_ = true;
+      detail::assign(base_, rgb.toHex() | (1u << 24), gen_);
       return *this;
     }
 
     Style& attrs(Attr attr)
     {
-      attrs_ |= static_cast<uint16_t>(attr);
-      dirty_ = true;
+      const uint16_t attrs = attrs_ | static_cast<uint16_t>(attr);
+      detail::assign(attrs_, attrs, gen_);
       return *this;
     }
     Style& attrs(const Style& attr)
     {
-      attrs_ |= attr.attrs_;
-      dirty_ = true;
+      const uint16_t attrs = attrs_ | attr.attrs_;
+      detail::assign(attrs_, attrs, gen_);
       return *this;
     }
 
@@ -85,36 +205,33 @@ public:
 
     void resetFg()
     {
-      fg_ = 0;
-      dirty_ = true;
+      detail::assign(fg_, 0u, gen_);
     }
     void resetBg()
     {
-      bg_ = 0;
-      dirty_ = true;
+      detail::assign(bg_, 0u, gen_);
     }
     void resetBase()
     {
-      base_ = 0;
-      dirty_ = true;
+      detail::assign(base_, 0u, gen_);
     }
     void resetAttrs()
     {
-      attrs_ = 0;
-      dirty_ = true;
+      detail::assign(attrs_, static_cast<uint16_t>(0), gen_);
     }
     void reset()
     {
-      fg_ = 0;
-      bg_ = 0;
-      base_ = 0;
-      attrs_ = 0;
-      dirty_ = true;
+      resetFg();
+      resetBg();
+      resetBase();
+      resetAttrs();
     }
 
   private:
     friend class Column;
-    bool& dirty_;
+
+    // the last change, see `detail::Generation`
+    detail::Generation gen_;
 
     // representing all the colors
     uint32_t fg_ = 0;
@@ -126,10 +243,6 @@ public:
   };
   class Config {
   public:
-    explicit Config(bool& dirty_) : dirty_(dirty_)
-    {
-    }
-
     Align align() const { return align_; }
     Padd padd() const { return padd_; }
     size_t width() const { return width_; }
@@ -138,48 +251,44 @@ public:
 
     Config& align(const Align alignment)
     {
-      align_ = alignment;
-      dirty_ = true;
+      detail::assign(align_, alignment, gen_);
       return *this;
     }
     Config& padd(const Padd padd)
     {
-      padd_ = padd;
-      dirty_ = true;
+      detail::assign(padd_, padd, gen_);
       return *this;
     }
     Config& width(const size_t width)
     {
-      width_ = width;
-      dirty_ = true;
+      detail::assign(width_, width, gen_);
       return *this;
     }
     Config& delimiter(std::string delimiter)
     {
-      delimiter_ = std::move(delimiter);
-      dirty_ = true;
+      detail::assign(delimiter_, std::move(delimiter), gen_);
       return *this;
     }
     Config& skipEmptyLineIndent(const bool skip)
     {
-      skipEmptyLineIndent_ = skip;
-      dirty_ = true;
+      detail::assign(skipEmptyLineIndent_, skip, gen_);
       return *this;
     }
 
     void reset()
     {
-      align_ = Align::Left;
-      padd_ = Padd();
-      delimiter_ = "-";
-      width_ = 0;
-      skipEmptyLineIndent_ = true;
-      dirty_ = true;
+      align(Align::Left);
+      padd(Padd());
+      delimiter("-");
+      width(0);
+      skipEmptyLineIndent(true);
     }
 
   private:
     friend class Column;
-    bool& dirty_;
+
+    // the last change, see `detail::Generation`
+    detail::Generation gen_;
 
     Align align_ = Align::Left;
     Padd padd_ = Padd();
@@ -188,44 +297,112 @@ public:
     bool skipEmptyLineIndent_ = true;
   };
 
+  // the content handed out by the mutable accessors, reading it isn't a
+  // change, writing through it is
+  class Content {
+  public:
+    operator const std::string&() const { return column_.content_; }
+    const std::string& str() const { return column_.content_; }
+
+    Content& operator=(std::string content)
+    {
+      column_.content(std::move(content));
+      return *this;
+    }
+    Content& operator+=(const std::string& str)
+    {
+      if (!str.empty()) column_.edit([&str](std::string& content) { content += str; });
+      return *this;
+    }
+    Content& operator+=(const char c)
+    {
+      column_.edit([c](std::string& content) { content += c; });
+      return *this;
+    }
+
+    size_t size() const { return column_.content_.size(); }
+    size_t length() const { return column_.content_.length(); }
+    bool empty() const { return column_.content_.empty(); }
+    const char* c_str() const { return column_.content_.c_str(); }
+    const char* data() const { return column_.content_.data(); }
+    char operator[](const size_t index) const { return column_.content_[index]; }
+
+    friend bool operator==(const Content& a, const Content& b) { return a.str() == b.str(); }
+    friend bool operator==(const Content& a, const std::string& b) { return a.str() == b; }
+    friend bool operator==(const std::string& a, const Content& b) { return a == b.str(); }
+    friend bool operator!=(const Content& a, const Content& b) { return a.str() != b.str(); }
+    friend bool operator!=(const Content& a, const std::string& b) { return a.str() != b; }
+    friend bool operator!=(const std::string& a, const Content& b) { return a != b.str(); }
+    friend bool operator<(const Content& a, const Content& b) { return a.str() < b.str(); }
+
+    friend std::ostream& operator<<(std::ostream& out, const Content& content)
+    {
+      return out << content.str();
+    }
+
+  private:
+    friend class Column;
+    Column& column_;
+
+    explicit Content(Column& column)
+      : column_(column)
+    {
+    }
+  };
+
+  // a character of the content, see `Content`
+  class Char {
+  public:
+    operator char() const { return column_.content_[index_]; }
+
+    Char& operator=(const char c)
+    {
+      if (c != column_.content_[index_])
+        column_.edit([this, c](std::string& content) { content[index_] = c; });
+      return *this;
+    }
+
+  private:
+    friend class Column;
+    Column& column_;
+    size_t index_;
+
+    Char(Column& column, const size_t index)
+      : column_(column), index_(index)
+    {
+    }
+  };
+
 public:
   Column() = default;
 
   Column(std::string content)
-    : content_(std::move(content)), dirty_(true)
+    : content_(std::move(content))
   {
+    gen_.bump();
   }
 
-  // copy constructor
-  // NOTE: if we don't initialize config_ and style_ with dirty_, and instead copy
-  // other.config_ and other.style_ we will get a heap-use-after-free error from the address sanitizer
-  // because config_ will still have the old dirty_ flag that points to the old object
-  // to avoid this we will initialize config_ and style_ with dirty_ of the current object
-  // and then copy the data of other.config_ and other.style_ one by one
-  // I didn't find a workaround solution except this :(
-  Column(const Column& other)
-    : lines_(other.lines_),
-    dirty_(other.dirty_),
-    config_(dirty_), // CRUCIAL
-    style_(dirty_), // CRUCIAL
-    content_(other.content_)
+  Column(const Column&) = default;
+  Column(Column&&) noexcept = default;
+  Column& operator=(const Column&) = default;
+  Column& operator=(Column&&) noexcept = default;
+
+  void content(std::string content)
   {
-    config_.align_ = other.config_.align_;
-    config_.padd_ = other.config_.padd_;
-    config_.delimiter_ = other.config_.delimiter_;
-    config_.width_ = other.config_.width_;
-    config_.skipEmptyLineIndent_ = other.config_.skipEmptyLineIndent_;
+    if (content == content_) return;
 
-    style_.fg_ = other.style_.fg_;
-    style_.bg_ = other.style_.bg_;
-    style_.base_ = other.style_.base_;
-    style_.attrs_ = other.style_.attrs_;
+    content_ = std::move(content);
+    gen_.bump();
+    infoDirty_ = true;
   }
 
-  void content(std::string content)
+  // changes the content in place with `edit(std::string&)`, e.g. to append
+  // to a long content without copying it
+  template <typename Edit> void edit(Edit&& edit)
   {
-    content_ = std::move(content);
-    dirty_ = true;
+    edit(content_);
+    gen_.bump();
+    infoDirty_ = true;
   }
 
   Config& config() { return config_; }
@@ -234,27 +411,20 @@ public:
   const Config& config() const { return config_; }
   const Style& style() const { return style_; }
 
+  // the mutable content isn't a change by itself, only what's written
+  // through it is, see `Content`
   const std::string& content() const { return content_; }
-  std::string& content()
-  {
-    dirty_ = true;
-    return content_;
-  }
+  Content content() { return Content(*this); }
 
   explicit operator const std::string&() const
   {
     return content_;
   }
-  explicit operator std::string&()
-  {
-    dirty_ = true;
-    return content_;
-  }
 
-  char& operator[](int index)
+  Char operator[](int index)
   {
-    dirty_ = true;
-    return content_.at(index);
+    content_.at(index); // throws if out of range
+    return Char(*this, static_cast<size_t>(index));
   }
   const char& operator[](int index) const
   {
@@ -263,26 +433,73 @@ public:
 
   void clr()
   {
-    content_.clear();
+    content(std::string());
     config_.reset();
     style_.reset();
     lines_.clear();
-    dirty_ = false;
+    linesWidth_ = 0;
+    linesGen_ = generation();
+  }
+
+  // changes whenever the content, the configuration or the style changes
+  uint64_t generation() const
+  {
+    return (std::max)(gen_, (std::max)(config_.gen_, style_.gen_));
+  }
+
+  const detail::ContentInfo& contentInfo() const
+  {
+    if (infoDirty_)
+    {
+      info_ = describe(content_);
+      infoDirty_ = false;
+    }
+    return info_;
+  }
+
+  // the narrowest width that doesn't break any word
+  size_t minWidth() const
+  {
+    const Padd padd = config().padd();
+    const size_t width = contentInfo().longestToken + padd.left + padd.right;
+
+    return (std::max)(width, static_cast<size_t>(MIN_COLUMN_WIDTH));
+  }
+
+  // the width that fits every line of the content without wrapping
+  size_t maxWidth() const
+  {
+    const Padd padd = config().padd();
+    const size_t width = contentInfo().longestLine + padd.left + padd.right;
+
+    return (std::max)(width, static_cast<size_t>(MIN_COLUMN_WIDTH));
   }
 
   const std::vector<std::string>& lines() const
   {
-    if (dirty_)
+    return lines(config().width());
+  }
+
+  // the lines of the column wrapped in `width` instead of the configured
+  // width, the table lays the columns out this way without touching them
+  const std::vector<std::string>& lines(const size_t width) const
+  {
+    if (!cached(width))
     {
-      lines_ = genLines();
-      dirty_ = false;
+      lines_ = genLines(width);
+      linesWidth_ = width;
+      linesGen_ = generation();
     }
     return lines_;
   }
+
   std::string genEmptyLine() const
+  {
+    return genEmptyLine(config().width());
+  }
+  std::string genEmptyLine(const size_t width) const
   {
     const std::string base = resolveBase();
-    const size_t width = config().width();
 
     std::string empty = base;
     empty.reserve(width);
@@ -294,21 +511,36 @@ public:
   }
 
 private:
+  // the row renders the columns without caching their lines
+  friend class Row;
+
   // cache
   mutable std::vector<std::string> lines_;
-  mutable bool dirty_ = false;
+  mutable size_t linesWidth_ = 0;
+  mutable uint64_t linesGen_ = 0;
+
+  // the last change of the content, see `detail::Generation`
+  detail::Generation gen_;
+
+  // content descriptor cache, only the content invalidates it
+  mutable detail::ContentInfo info_;
+  mutable bool infoDirty_ = true;
 
-  Config config_{dirty_};
-  Style style_{dirty_};
+  Config config_;
+  Style style_;
   std::string content_;
 
-  std::vector<std::string> genLines() const
+  bool cached(const size_t width) const
+  {
+    return linesGen_ == generation() && width == linesWidth_;
+  }
+  std::vector<std::string> genLines(const size_t columnWidth) const
   {
     std::string delimiter = config().delimiter();
     size_t delimiterDw = string_utils::dw(delimiter);
     Padd padd = config().padd();
 
-    size_t width = config().width();
+    size_t width = columnWidth;
     if (width < MIN_COLUMN_WIDTH) width = MIN_COLUMN_WIDTH;
 
     if (padd.right + padd.left >= width)
@@ -325,15 +557,19 @@ private:
       delimiterDw = 0;
     }
 
-    // split the content into words
-    const auto words = split(content_);
+    // most cells are short values that fit in a single line, format them
+    // directly without splitting and wrapping
+    if (isSingleLine(width)) return formatSingleLine(padd, columnWidth);
 
-    // wrap the words into lines
+    // split the content into tokens
+    const auto tokens = tokenize(content_);
+
+    // wrap the tokens into lines
     const std::vector<detail::Str> lines =
-        wrap(words, width, delimiter, delimiterDw);
+        wrap(tokens, width, delimiter, delimiterDw);
 
     // format the lines handling padding, alignment and the base styles
-    return format(lines, padd);
+    return format(lines, padd, columnWidth);
   }
   static void handleColor(std::string& styles, detail::ColorType colortype,
                           bool back)
@@ -352,6 +588,12 @@ private:
       styles += std::to_string(rgb.g) + ';';
       styles += std::to_string(rgb.b) + ';';
     }
+
+    else if (colortype.isPalette())
+    {
+      styles += back ? "48;5;" : "38;5;";
+      styles += std::to_string(colortype.palette()) + ';';
+    }
   }
   static void handleAttrs(std::string& styles, Attr attr)
   {
@@ -371,21 +613,35 @@ private:
     if (hasAttr(attr, Attr::Crossed)) styles += "9;";
   }
 
-  std::string resolveStyles() const
+  static std::string resolveSgr(const detail::Sgr& sgr)
   {
     std::string styles = "\x1b[";
 
-    if (style().hasAttrs()) handleAttrs(styles, style().attrs());
+    if (sgr.attrs != 0) handleAttrs(styles, static_cast<Attr>(sgr.attrs));
 
-    if (style().hasFg()) handleColor(styles, style().fg(), false);
+    if (sgr.fg != 0) handleColor(styles, sgr.fg, false);
 
-    if (style().hasBg()) handleColor(styles, style().bg(), true);
+    if (sgr.bg == detail::Sgr::defaultBg) styles += "49;";
+    else if (sgr.bg != 0) handleColor(styles, sgr.bg, true);
 
     if (styles == "\x1b[") return ""; // empty
 
     if (styles.back() == ';') styles.back() = 'm';
     return styles;
   }
+  detail::Sgr styleSgr() const
+  {
+    detail::Sgr sgr;
+    sgr.fg = style().fg();
+    sgr.bg = style().bg();
+    sgr.attrs = static_cast<uint16_t>(style().attrs());
+
+    return sgr;
+  }
+  std::string resolveStyles() const
+  {
+    return resolveSgr(styleSgr());
+  }
   std::string resolveBase() const
   {
     std::string base = "\x1b[";
@@ -397,56 +653,179 @@ private:
     return base;
   }
 
-  std::vector<std::string> split(const std::string& str) const
+  // whether the content is plain text (no escape sequences or special
+  // spaces) that fits in `width`
+  bool isSingleLine(const size_t width) const
+  {
+    const detail::ContentInfo& info = contentInfo();
+    if (content_.empty() || info.hasEscapes || info.hasNewlines || info.hasSpaces)
+      return false;
+
+    // leading spaces may be skipped, leave them to the wrapper
+    if (content_[0] == ' ' && config_.skipEmptyLineIndent()) return false;
+
+    return info.dw <= width;
+  }
+  static detail::ContentInfo describe(const std::string& str)
+  {
+    using namespace string_utils;
+
+    detail::ContentInfo info;
+
+    const char* ptr = str.data();
+    const char* end = ptr + str.length();
+
+    size_t lineDw = 0, tokenDw = 0;
+    auto endToken = [&]() {
+      if (tokenDw > info.longestToken) info.longestToken = tokenDw;
+      tokenDw = 0;
+    };
+    auto endLine = [&]() {
+      endToken();
+      if (lineDw > info.longestLine) info.longestLine = lineDw;
+      lineDw = 0;
+    };
+
+    while (ptr < end)
+    {
+      // printable ascii characters are 1 column each
+      const char* run = ptr + detail::asciiRun(ptr, end);
+      for (; ptr < run; ++ptr)
+      {
+        if (*ptr == ' ') endToken();
+        else ++tokenDw;
+
+        ++lineDw;
+        ++info.dw;
+      }
+
+      if (ptr == end) break;
+
+      if (*ptr == '\n')
+      {
+        info.hasNewlines = true;
+        endLine();
+        ++ptr;
+        continue;
+      }
+
+      // the wrapper ignores other space characters
+      if (isSpace(*ptr))
+      {
+        info.hasSpaces = true;
+        endToken();
+        ++ptr;
+        continue;
+      }
+
+      info.ascii = false;
+
+      // escape sequences split words, the same way `tokenize` reads them
+      if (*ptr == '\x1b')
+      {
+        info.hasEscapes = true;
+        endToken();
+
+        ++ptr;
+        while (ptr < end && isAscii(*ptr) && !isAlpha(*ptr))
+          ++ptr;
+
+        if (ptr < end) ++ptr;
+        continue;
+      }
+
+      // the same way `dw` measures the character, invalid bytes are 1 wide
+      size_t charDw = 1;
+      uint32_t wc;
+      int consumed = 1;
+      if (utf8twc(ptr, static_cast<size_t>(end - ptr), wc, consumed))
+      {
+        charDw = wcwidth(wc);
+        ptr += consumed;
+      }
+      else
+        ++ptr;
+
+      tokenDw += charDw;
+      lineDw += charDw;
+      info.dw += charDw;
+    }
+
+    endLine();
+    return info;
+  }
+  std::vector<detail::Token> tokenize(const std::string& str) const
   {
     using namespace string_utils;
+    using Kind = detail::Token::Kind;
 
+    const char* data = str.data();
     const size_t len = str.length();
 
-    std::vector<std::string> words;
-    words.reserve((len / WORD_LENGTH_AVERAGE) + 1); // average
+    // the words of ascii content are as wide as they are long
+    const bool ascii = contentInfo().ascii;
 
-    std::string buffer;
-    buffer.reserve(WORD_LENGTH_AVERAGE);
+    std::vector<detail::Token> tokens;
+    tokens.reserve((len / WORD_LENGTH_AVERAGE) + 1); // average
 
+    auto push = [&](size_t offset, size_t length, Kind kind) {
+      const bool measured = ascii && kind == Kind::Word;
+      const size_t width = measured ? length : dw(data + offset, length);
+      tokens.push_back({offset, length, width, kind});
+    };
+
+    size_t start = 0; // the beginning of the current word
     size_t i = 0;
     while (i < len)
     {
-      if (str[i] == '\x1b')
+      if (data[i] == '\x1b')
       {
-        if (!buffer.empty()) words.emplace_back(std::move(buffer));
-        buffer.clear();
+        if (i > start) push(start, i - start, Kind::Word);
+        start = i;
 
-        while (i < len && isAscii(str[i]) && !isAlpha(str[i]))
-          buffer += str[i++];
+        while (i < len && isAscii(data[i]) && !isAlpha(data[i]))
+          ++i;
 
-        if (i < len) buffer += str[i++];
-        words.emplace_back(std::move(buffer));
-        buffer.clear();
+        if (i < len) ++i;
+
+        Kind kind = Kind::Ignored;
+        if (data[i - 1] == 'm')
+        {
+          const bool reset = str.compare(start, i - start, RESET_ESC) == 0;
+          kind = reset ? Kind::Reset : Kind::Escape;
+        }
+
+        push(start, i - start, kind);
+        start = i;
         continue;
       }
 
-      if (isSpace(str[i]))
+      if (isSpace(data[i]))
       {
-        if (!buffer.empty()) words.emplace_back(std::move(buffer));
-        buffer.clear();
+        if (i > start) push(start, i - start, Kind::Word);
+
+        Kind kind = Kind::Ignored;
+        if (data[i] == ' ') kind = Kind::Space;
+        else if (data[i] == '\n') kind = Kind::Newline;
 
-        words.emplace_back(1, str[i++]);
+        push(i, 1, kind);
+        start = ++i;
         continue;
       }
 
-      buffer += str[i++];
+      ++i;
     }
 
-    if (!buffer.empty()) words.emplace_back(std::move(buffer));
-    return words;
+    if (i > start) push(start, i - start, Kind::Word);
+    return tokens;
   }
-  std::vector<detail::Str> wrap(const std::vector<std::string>& words,
+  std::vector<detail::Str> wrap(const std::vector<detail::Token>& tokens,
                                 const size_t width,
                                 const std::string& delimiter,
                                 const size_t delimiterDw) const
   {
     using namespace string_utils;
+    using Kind = detail::Token::Kind;
 
     const std::string styles = resolveStyles();
     const bool skipBlanks = config_.skipEmptyLineIndent();
@@ -461,13 +840,24 @@ private:
     if (!styles.empty()) buffer += styles;
 
     // in case the line contains active escape sequences, and they were NOT
-    // reset (with '\x1b[0m'), we need to register them, reset them
-    // at the end of the line, and restore them in the next line.
-    std::string activeEscs;
+    // reset (with '\x1b[0m'), we need to track them, reset them at the end
+    // of the line, and restore them in the next line. the column styles and
+    // the active escape sequences are restored with a single sequence.
+    const detail::Sgr base = styleSgr();
+    detail::Sgr active = base;
+    std::string activeEscs = styles;
+
+    // whether escape sequences were applied since the last reset, even if
+    // they cancel each other and `activeEscs` ends up empty
+    bool pending = false;
+
+    // whether the current line started with carried over escape sequences,
+    // the line is never considered empty then, even if `activeEscs` is
+    bool carried = false;
 
     // helper lambdas to avoid repeating code
     auto appendResetIfNeeded = [&]() {
-      if (!(activeEscs.empty() && styles.empty()) && !endsWith(buffer, RESET_ESC))
+      if ((pending || !styles.empty()) && !endsWith(buffer, RESET_ESC))
         buffer += RESET_ESC;
     };
     auto startNewLine = [&]() {
@@ -477,60 +867,63 @@ private:
       buffer.clear();
       bufferDw = 0;
 
-      if (!styles.empty()) buffer += styles;
-      if (!activeEscs.empty()) buffer += activeEscs;
+      buffer += activeEscs;
+      carried = pending;
     };
 
-    for (size_t i = 0; i < words.size(); ++i)
+    for (size_t i = 0; i < tokens.size(); ++i)
     {
-      std::string word = words[i];
-
-      // SKIP empty strings
-      if (word.empty()) continue;
+      const detail::Token& token = tokens[i];
+      const char* word = content_.data() + token.offset;
 
       // SKIP spaces at the start of a new line
-      if (skipBlanks && buffer.empty() && word == " ") continue;
+      if (skipBlanks && buffer.empty() && !carried && token.kind == Kind::Space)
+        continue;
 
       // HANDLE new lines
-      if (word == "\n")
+      if (token.kind == Kind::Newline)
       {
         startNewLine();
         continue;
       }
 
-      // IGNORE other space characters
-      if (word.length() == 1 && isSpace(word[0]) && word != " ") continue;
+      // IGNORE other space characters and escape sequences
+      if (token.kind == Kind::Ignored) continue;
 
       // HANDLE escape sequences
-      if (word[0] == '\x1b')
+      if (token.kind == Kind::Escape || token.kind == Kind::Reset)
       {
-        if (word.back() != 'm') continue;
+        const bool nextFits =
+            i + 1 < tokens.size() && tokens[i + 1].dw + bufferDw <= width;
 
-        const auto* nextWord = i + 1 < words.size() ? &words[i + 1] : nullptr;
-        if (word == "\x1b[0m")
+        if (token.kind == Kind::Reset)
         {
-          activeEscs.clear();
-          buffer += word;
+          active = base;
+          activeEscs = styles;
+          pending = false;
+          buffer.append(word, token.length);
 
-          if (nextWord && dw(*nextWord) + bufferDw <= width) buffer += styles;
+          if (nextFits) buffer += styles;
 
           continue;
         }
 
-        activeEscs += word;
+        active.apply(word, token.length);
+        activeEscs = resolveSgr(active);
+        pending = true;
 
-        if (nextWord && dw(*nextWord) + bufferDw <= width) buffer += word;
+        if (nextFits) buffer.append(word, token.length);
 
         continue;
       }
 
       // word display width
-      size_t wordDw = dw(word);
+      size_t wordDw = token.dw;
 
       // the word fits in the line
       if (wordDw + bufferDw <= width)
       {
-        buffer += word;
+        buffer.append(word, token.length);
         bufferDw += wordDw;
         continue;
       }
@@ -541,9 +934,9 @@ private:
         startNewLine();
 
         // add the next word and avoid spaces
-        if (word != " ")
+        if (token.kind != Kind::Space)
         {
-          buffer += word;
+          buffer.append(word, token.length);
           bufferDw += wordDw;
         }
 
@@ -558,52 +951,75 @@ private:
       // no free space, append the current line and process the others
       if (bufferDw >= width - delimiterDw) startNewLine();
 
+      // walk the word once, `start` is where the rest of it begins
+      const char* data = word;
+      const size_t len = token.length;
+      size_t start = 0;
+
       while (wordDw > width)
       {
-        size_t limit = width - delimiterDw - bufferDw;
-
-        std::string firstPart;
-        size_t firstPartDw = 0;
-        firstPart.reserve(limit);
+        const size_t limit = width - delimiterDw - bufferDw;
 
-        size_t pos = 0;
-        while (firstPartDw < limit)
+        size_t partDw = 0;
+        size_t pos = start;
+        while (partDw < limit && pos < len)
         {
-          std::string utf8char = readUtf8Char(word, pos);
-          size_t utf8charDw = dw(utf8char);
+          // printable ascii characters are 1 column each, take them in bulk
+          const size_t room = (std::min)(limit - partDw, len - pos);
+          const size_t run = detail::asciiRun(data + pos, data + pos + room);
+          if (run > 0)
+          {
+            partDw += run;
+            pos += run;
+            continue;
+          }
+
+          // invalid bytes are taken one by one, the same way `dw` counts them
+          size_t charLen = utf8CharLen(data, len, pos);
+          if (charLen == 0) charLen = 1;
+
+          const size_t charDw = dw(data + pos, charLen);
 
           // if it will exceed the limit don't append
-          if (utf8charDw + firstPartDw > limit) break;
+          if (charDw + partDw > limit)
+          {
+            // it doesn't fit even in an empty line, take it anyway to make
+            // progress, and drop the delimiter if there's no room for it
+            if (bufferDw == 0 && pos == start)
+            {
+              partDw += charDw;
+              pos += charLen;
+            }
+            break;
+          }
 
           // otherwise append this part
-          firstPart += utf8char;
-          firstPartDw += utf8charDw;
-
-          if (utf8char.empty()) pos++;
-          else pos += utf8char.length();
+          partDw += charDw;
+          pos += charLen;
         }
 
-        // prepare the next word
-        word = word.substr(pos);
-        wordDw -= firstPartDw;
+        // add the part and the delimiter into the buffer
+        buffer.append(data + start, pos - start);
+        bufferDw += partDw;
+        wordDw -= partDw;
 
-        // add the delimiter
-        firstPart += delimiter;
-        firstPartDw += delimiterDw;
+        if (bufferDw + delimiterDw <= width)
+        {
+          buffer += delimiter;
+          bufferDw += delimiterDw;
+        }
 
-        // add the stuff into the buffer
-        buffer += firstPart;
-        bufferDw += firstPartDw;
+        start = pos;
 
         // append a new line
         startNewLine();
       }
 
-      buffer += word;
+      buffer.append(data + start, len - start);
       bufferDw += wordDw;
     }
 
-    if (!buffer.empty())
+    if (!buffer.empty() || carried)
     {
       appendResetIfNeeded();
       lines.push_back({buffer, bufferDw});
@@ -612,19 +1028,17 @@ private:
     return lines;
   }
   std::vector<std::string> format(const std::vector<detail::Str>& lines,
-                                  const Padd padd) const
+                                  const Padd padd, const size_t width) const
   {
     using namespace string_utils;
 
-    const size_t width = config().width();
     const std::string base = resolveBase();
-    const Align align = config().align();
 
     std::vector<std::string> formatted;
     formatted.reserve(lines.size() + padd.top + padd.bottom);
 
     const bool styled = !base.empty();
-    const std::string empty = genEmptyLine();
+    const std::string empty = genEmptyLine(width);
     formatted.insert(formatted.end(), padd.top, empty);
 
     // temporary buffer
@@ -636,27 +1050,8 @@ private:
       // append the base styles
       if (styled) buffer += base;
 
-      // calculate the total line width
-      const size_t lineWidth = line.dw + padd.left + padd.right;
-      const size_t freeSpace = (width > lineWidth) ? width - lineWidth : 0;
-
       size_t leftSpace = 0, rightSpace = 0;
-      switch (align)
-      {
-      case Align::Left:
-        leftSpace = 0;
-        rightSpace = freeSpace;
-        break;
-      case Align::Center: {
-        leftSpace = freeSpace / 2;
-        rightSpace = freeSpace - leftSpace;
-        break;
-      }
-      case Align::Right:
-        leftSpace = freeSpace;
-        rightSpace = 0;
-        break;
-      }
+      alignLine(line.dw, padd, width, leftSpace, rightSpace);
 
       buffer.append(leftSpace + padd.left, ' ');
       buffer += line.str;
@@ -675,6 +1070,84 @@ private:
     formatted.insert(formatted.end(), padd.bottom, empty);
     return formatted;
   }
+  std::vector<std::string> formatSingleLine(const Padd padd,
+                                            const size_t width) const
+  {
+    const size_t contentDw = contentInfo().dw;
+    const std::string base = resolveBase();
+    const std::string styles = resolveStyles();
+    const size_t resetLen = std::char_traits<char>::length(RESET_ESC);
+
+    size_t leftSpace = 0, rightSpace = 0;
+    alignLine(contentDw, padd, width, leftSpace, rightSpace);
+
+    leftSpace += padd.left;
+    rightSpace += padd.right;
+
+    // the same layout `wrap` and `format` produce for a single line
+    size_t size = leftSpace + content_.length() + rightSpace;
+    if (!base.empty()) size += base.length() + resetLen;
+    if (!styles.empty()) size += styles.length() + resetLen + base.length();
+
+    std::string line;
+    line.reserve(size);
+
+    line += base;
+    line.append(leftSpace, ' ');
+
+    if (!styles.empty())
+    {
+      line += styles;
+      line += content_;
+      line += RESET_ESC;
+      line += base;
+    }
+    else
+      line += content_;
+
+    line.append(rightSpace, ' ');
+    if (!base.empty()) line += RESET_ESC;
+
+    std::vector<std::string> formatted;
+    formatted.reserve(1 + padd.top + padd.bottom);
+
+    if (padd.top + padd.bottom > 0)
+    {
+      const std::string empty = genEmptyLine(width);
+      formatted.insert(formatted.end(), padd.top, empty);
+      formatted.emplace_back(std::move(line));
+      formatted.insert(formatted.end(), padd.bottom, empty);
+    }
+    else
+      formatted.emplace_back(std::move(line));
+
+    return formatted;
+  }
+  // calculates the spaces around a line of display width `lineDw`
+  void alignLine(const size_t lineDw, const Padd padd, const size_t width,
+                 size_t& leftSpace, size_t& rightSpace) const
+  {
+    // calculate the total line width
+    const size_t lineWidth = lineDw + padd.left + padd.right;
+    const size_t freeSpace = (width > lineWidth) ? width - lineWidth : 0;
+
+    switch (config().align())
+    {
+    case Align::Left:
+      leftSpace = 0;
+      rightSpace = freeSpace;
+      break;
+    case Align::Center: {
+      leftSpace = freeSpace / 2;
+      rightSpace = freeSpace - leftSpace;
+      break;
+    }
+    case Align::Right:
+      leftSpace = freeSpace;
+      rightSpace = 0;
+      break;
+    }
+  }
 };
 // clang-format on
 
@@ -0,0 +1,145 @@
+#pragma once
+
+#include "virtual_table.h"
+
+#include <map>
+
+namespace tabular {
+// clang-format off
+// a table stored column by column, for tables whose rows all have the same
+// columns. the contents of a column are kept back to back in a single
+// string, its configuration and style once, and only the cells that differ
+// keep their own. it's rendered through a `VirtualTable`:
+//
+//   ColumnStore store(3);
+//   store.addRow({"1", "Alice", "admin"});
+//   render(VirtualTable(store), stdout);
+//
+// NOTE: the rows are only appended, see `addRow()`
+class ColumnStore : public Source {
+public:
+  explicit ColumnStore(const size_t columns)
+    : fields_(columns)
+  {
+  }
+
+  size_t rows() const override { return rows_; }
+  size_t columns() const override { return fields_.size(); }
+
+  ColumnStore& addRow(const std::vector<std::string>& row)
+  {
+    if (row.size() != fields_.size())
+    {
+      throw std::runtime_error(
+        "layout error: the row has " + std::to_string(row.size()) +
+        " columns, but the table has " + std::to_string(fields_.size()));
+    }
+
+    for (size_t j = 0; j < row.size(); ++j)
+    {
+      Field& field = fields_[j];
+      field.pool += row[j];
+      field.offsets.push_back(field.pool.size());
+    }
+
+    rows_++;
+    return *this;
+  }
+
+  // reserves the memory of `rows` rows of `bytes` bytes per cell on average
+  void reserve(const size_t rows, const size_t bytes = 0)
+  {
+    for (auto& field : fields_)
+    {
+      field.offsets.reserve(rows);
+      field.pool.reserve(rows * bytes);
+    }
+  }
+
+  std::string content(const size_t row, const size_t column) const
+  {
+    const Field& field = fields_.at(column);
+    const size_t begin = row > 0 ? field.offsets.at(row - 1) : 0;
+
+    return field.pool.substr(begin, field.offsets.at(row) - begin);
+  }
+
+  // the configuration and style of every cell of the column
+  Column::Config& config(const size_t column) { return fields_.at(column).format.config; }
+  Column::Style& style(const size_t column) { return fields_.at(column).format.style; }
+
+  const Column::Config& config(const size_t column) const { return fields_.at(column).format.config; }
+  const Column::Style& style(const size_t column) const { return fields_.at(column).format.style; }
+
+  // the configuration and style of a single cell, they start as the
+  // column's ones and don't follow them after that
+  Column::Config& config(const size_t row, const size_t column) { return format(row, column).config; }
+  Column::Style& style(const size_t row, const size_t column) { return format(row, column).style; }
+
+  void cell(const size_t row, const size_t column, Column& cell) const override
+  {
+    const Format& format = this->format(row, column);
+
+    cell.config() = format.config;
+    cell.style() = format.style;
+    cell.content(content(row, column));
+  }
+
+  // the cells of a column are measured one after the other
+  bool measure(const size_t column, size_t& width, size_t& minimum,
+               size_t& maximum) const override
+  {
+    Column cell;
+    for (size_t i = 0; i < rows_; ++i)
+    {
+      this->cell(i, column, cell);
+
+      width = (std::max)(width, cell.config().width());
+      minimum = (std::max)(minimum, cell.minWidth());
+      maximum = (std::max)(maximum, cell.maxWidth());
+    }
+
+    return true;
+  }
+
+private:
+  struct Format {
+    Column::Config config;
+    Column::Style style;
+  };
+
+  struct Field {
+    // the contents back to back, and where each one ends
+    std::string pool;
+    std::vector<size_t> offsets;
+
+    Format format;
+
+    // the cells with their own format
+    std::map<size_t, Format> formats;
+  };
+
+  std::vector<Field> fields_;
+  size_t rows_ = 0;
+
+  Format& format(const size_t row, const size_t column)
+  {
+    if (row >= rows_) throw std::out_of_range("the row doesn't exist");
+
+    Field& field = fields_.at(column);
+    auto it = field.formats.find(row);
+    if (it == field.formats.end())
+      it = field.formats.emplace(row, field.format).first;
+
+    return it->second;
+  }
+  const Format& format(const size_t row, const size_t column) const
+  {
+    const Field& field = fields_.at(column);
+    auto it = field.formats.find(row);
+
+    return it == field.formats.end() ? field.format : it->second;
+  }
+};
+// clang-format on
+} // namespace tabular
@@ -0,0 +1,183 @@
+#pragma once
+
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "global.h"
+
+namespace tabular {
+// clang-format off
+// the width of the columns at the same index in every row of a table, see
+// `Table::Config::columns()`. a column is either flexible, sharing the space
+// left by the others relative to its weight, fixed, or a percentage of the
+// space of all the columns (the table's width without the vertical borders).
+// any of them can be bounded with `min()` and `max()`
+class ColumnWidth {
+public:
+  enum class Kind { Flex, Fixed, Percent };
+
+  ColumnWidth() = default;
+
+  static ColumnWidth Flex(const size_t weight = 1)
+  {
+    return ColumnWidth(Kind::Flex, (std::max)(weight, size_t(1)));
+  }
+  static ColumnWidth Fixed(const size_t width)
+  {
+    return ColumnWidth(Kind::Fixed, width);
+  }
+  static ColumnWidth Percent(const size_t percent)
+  {
+    return ColumnWidth(Kind::Percent, (std::min)(percent, size_t(100)));
+  }
+
+  ColumnWidth& min(const size_t width)
+  {
+    min_ = width;
+    return *this;
+  }
+  ColumnWidth& max(const size_t width)
+  {
+    max_ = width;
+    return *this;
+  }
+
+  Kind kind() const { return kind_; }
+
+  // the weight, the width or the percentage
+  size_t value() const { return value_; }
+
+  // zero if unbounded
+  size_t min() const { return min_; }
+  size_t max() const { return max_; }
+
+  bool operator==(const ColumnWidth& other) const
+  {
+    return kind_ == other.kind_ && value_ == other.value_ &&
+           min_ == other.min_ && max_ == other.max_;
+  }
+  bool operator!=(const ColumnWidth& other) const { return !(*this == other); }
+
+private:
+  Kind kind_ = Kind::Flex;
+  size_t value_ = 1;
+  size_t min_ = 0;
+  size_t max_ = 0;
+
+  ColumnWidth(const Kind kind, const size_t value)
+    : kind_(kind), value_(value)
+  {
+  }
+};
+// clang-format on
+
+namespace detail {
+// the widths of `columns` columns sharing `available`, the columns past the
+// end of `spec` are flexible. throws if they can't fit
+inline std::vector<size_t> resolveWidths(const std::vector<ColumnWidth>& spec,
+                                         const size_t columns,
+                                         const size_t available)
+{
+  std::vector<size_t> widths(columns, 0);
+  std::vector<size_t> lows(columns, MIN_COLUMN_WIDTH);
+  std::vector<size_t> highs(columns, available);
+  std::vector<bool> flexible(columns, true);
+  std::vector<bool> fixed(columns, false);
+
+  size_t used = 0;
+  for (size_t i = 0; i < columns; ++i)
+  {
+    const ColumnWidth width = i < spec.size() ? spec[i] : ColumnWidth();
+
+    lows[i] = (std::max)(lows[i], width.min());
+    if (width.max() != 0) highs[i] = (std::max)(width.max(), lows[i]);
+
+    if (width.kind() == ColumnWidth::Kind::Flex) continue;
+
+    size_t w = width.value();
+    if (width.kind() == ColumnWidth::Kind::Percent)
+      w = available * width.value() / 100;
+
+    // a fixed width wider than the table throws below instead of shrinking
+    widths[i] = (std::max)(w, lows[i]);
+    if (width.max() != 0) widths[i] = (std::min)(widths[i], highs[i]);
+
+    flexible[i] = false;
+    fixed[i] = width.kind() == ColumnWidth::Kind::Fixed;
+    used += widths[i];
+  }
+
+  // the flexible columns share the rest relative to their weights, the ones
+  // that hit a bound take it and the others share again what's left
+  std::vector<bool> frozen(flexible);
+  frozen.flip();
+
+  while (true)
+  {
+    size_t weights = 0, space = available;
+    for (size_t i = 0; i < columns; ++i)
+    {
+      if (!frozen[i]) weights += i < spec.size() ? spec[i].value() : 1;
+      else space -= (std::min)(space, widths[i]);
+    }
+
+    if (weights == 0) break;
+
+    bool clamped = false;
+    for (size_t i = 0; i < columns; ++i)
+    {
+      if (frozen[i]) continue;
+
+      const size_t weight = i < spec.size() ? spec[i].value() : 1;
+      const size_t w = space * weight / weights;
+
+      widths[i] = (std::min)((std::max)(w, lows[i]), highs[i]);
+      if (widths[i] != w)
+      {
+        frozen[i] = true;
+        clamped = true;
+      }
+    }
+
+    if (!clamped) break;
+  }
+
+  used = 0;
+  for (const size_t w : widths)
+    used += w;
+
+  if (used > available)
+  {
+    throw std::runtime_error(
+      "layout error: the columns must have a minimum width of " +
+      std::to_string(used) + ", but found " + std::to_string(available));
+  }
+
+  // the rounding leftovers go to the flexible columns, or else to the
+  // percentage ones, the fixed ones never grow. what no column can take is
+  // left out, the table is narrower than its width then
+  for (const bool percent : {false, true})
+  {
+    auto taker = [&](const size_t i) {
+      return (flexible[i] || (percent && !fixed[i])) && widths[i] < highs[i];
+    };
+
+    size_t takers = 0;
+    for (size_t i = 0; i < columns; ++i)
+      takers += taker(i);
+
+    for (size_t i = 0; takers > 0 && used < available; i = (i + 1) % columns)
+    {
+      if (!taker(i)) continue;
+
+      widths[i]++;
+      used++;
+      if (widths[i] >= highs[i]) takers--;
+    }
+  }
+
+  return widths;
+}
+} // namespace detail
+} // namespace tabular
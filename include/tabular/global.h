@@ -1,6 +1,9 @@
 #pragma once
 
+#include <atomic>
+#include <cstddef>
 #include <cstdint>
+#include <utility>
 
 namespace tabular {
 enum class Attr : uint16_t {
@@ -34,6 +37,13 @@ struct Padd {
       : top(top), bottom(bottom), left(left), right(right)
   {
   }
+
+  constexpr bool operator==(const Padd& other) const
+  {
+    return top == other.top && bottom == other.bottom && left == other.left &&
+           right == other.right;
+  }
+  constexpr bool operator!=(const Padd& other) const { return !(*this == other); }
 };
 
 constexpr auto RESET_ESC = "\x1b[0m";
@@ -42,4 +52,53 @@ constexpr uint64_t DEFAULT_WIDTH = 50;
 
 // the maximum display width of a Unicode character
 constexpr uint8_t MIN_COLUMN_WIDTH = 2;
+
+// the rows rendered by a single task when the rows are rendered in parallel
+constexpr size_t ROWS_PER_TASK = 256;
+
+// the separators between rows layouts a table remembers
+constexpr size_t MAX_MEMOIZED_SEPARATORS = 64;
+
+namespace detail {
+// a new stamp for an object that just changed, stamps are unique and always
+// increasing, so comparing the stamp of an object with the one its cache was
+// generated with tells whether it changed since, even if it was replaced by
+// another object
+inline uint64_t nextGeneration()
+{
+  static std::atomic<uint64_t> generation{0};
+  return generation.fetch_add(1, std::memory_order_relaxed) + 1;
+}
+
+// the stamp of an object's last change. copies keep it since they hold the
+// same state, but assigning over an object changes it, so handing out
+// references never has to count as a change
+class Generation {
+public:
+  Generation() = default;
+  Generation(const Generation&) = default;
+
+  Generation& operator=(const Generation&) noexcept
+  {
+    bump();
+    return *this;
+  }
+
+  void bump() noexcept { value_ = nextGeneration(); }
+  operator uint64_t() const noexcept { return value_; }
+
+private:
+  uint64_t value_ = 0;
+};
+
+// sets a field of an object, setting the value it already has isn't a change
+template<typename T, typename U>
+void assign(T& field, U&& value, Generation& generation)
+{
+  if (field == value) return;
+
+  field = std::forward<U>(value);
+  generation.bump();
+}
+} // namespace detail
 } // namespace tabular
@@ -0,0 +1,74 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+namespace tabular {
+// runs `task(0)`, ..., `task(count - 1)` and returns once they're all done,
+// e.g. by handing them to a thread pool, see `Table::Config::executor()`
+using Executor =
+  std::function<void(size_t count, const std::function<void(size_t)>& task)>;
+
+namespace detail {
+// runs the tasks on the given executor, or on up to `threads` threads with
+// the calling one included. the first exception thrown by a task is thrown
+// again once they're all done
+inline void parallelFor(const Executor* executor, size_t threads,
+                        const size_t count,
+                        const std::function<void(size_t)>& task)
+{
+  std::exception_ptr error;
+  std::mutex mutex;
+
+  auto guarded = [&](const size_t index) {
+    try
+    {
+      task(index);
+    }
+    catch (...)
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      if (!error) error = std::current_exception();
+    }
+  };
+
+  if (executor != nullptr)
+    (*executor)(count, guarded);
+
+  else
+  {
+    std::atomic<size_t> next{0};
+    auto work = [&]() {
+      for (size_t i = next++; i < count; i = next++)
+        guarded(i);
+    };
+
+    std::vector<std::thread> workers;
+    threads = (std::min)(threads, count);
+    workers.reserve(threads);
+
+    // fewer threads if the system refuses to start them
+    try
+    {
+      for (size_t i = 1; i < threads; ++i)
+        workers.emplace_back(work);
+    }
+    catch (const std::system_error&)
+    {
+    }
+
+    work();
+    for (auto& worker : workers)
+      worker.join();
+  }
+
+  if (error) std::rethrow_exception(error);
+}
+} // namespace detail
+} // namespace tabular
@@ -1,5 +1,8 @@
 #pragma once
 
+#include "table.h"
+
+#include <cstdio>
 #include <string>
 
 #if defined(_WIN32) || defined(_WIN64)
@@ -8,9 +11,9 @@
 #endif
 
 namespace tabular {
-  inline void render(const std::string& str, FILE* out)
+  inline void render(const char* str, const size_t len, FILE* out)
   {
-    if (str.empty())
+    if (len == 0)
       return;
 
 #if defined(_WIN32) || defined(_WIN64)
@@ -31,34 +34,48 @@ namespace tabular {
 
     if (!GetConsoleMode(handle, &mode))
     {
-      WriteFile(handle, str.c_str(), str.length(), &written, nullptr);
+      WriteFile(handle, str, static_cast<DWORD>(len), &written, nullptr);
       return;
     }
 
     // convert UTF-8 to UTF-16 because it's Windows
-    int wlen = MultiByteToWideChar(CP_UTF8, 0, str.c_str(), -1, nullptr, 0);
+    const int ilen = static_cast<int>(len);
+    int wlen = MultiByteToWideChar(CP_UTF8, 0, str, ilen, nullptr, 0);
 
     // fallback
     if (wlen <= 0)
     {
-      WriteFile(handle, str.c_str(), str.length(), &written, nullptr);
+      WriteFile(handle, str, static_cast<DWORD>(len), &written, nullptr);
       return;
     }
 
     wchar_t* buffer = new wchar_t[wlen];
-    int result = MultiByteToWideChar(CP_UTF8, 0, str.c_str(), -1, buffer, wlen);
+    int result = MultiByteToWideChar(CP_UTF8, 0, str, ilen, buffer, wlen);
 
     if (result <= 0)
     {
       delete[] buffer;
-      WriteFile(handle, str.c_str(), str.length(), &written, nullptr);
+      WriteFile(handle, str, static_cast<DWORD>(len), &written, nullptr);
       return;
     }
 
-    WriteConsoleW(handle, buffer, static_cast<DWORD>(wlen - 1), &written, nullptr);
+    WriteConsoleW(handle, buffer, static_cast<DWORD>(wlen), &written, nullptr);
     delete[] buffer;
 #else
-    fwrite(str.c_str(), 1, str.length(), out);
+    fwrite(str, 1, len, out);
 #endif
   }
+
+  inline void render(const std::string& str, FILE* out)
+  {
+    render(str.data(), str.length(), out);
+  }
+
+  // streams the table into `out` row by row, without building its string
+  inline void render(const Table& table, FILE* out)
+  {
+    table.render([out](const char* str, const size_t len) {
+      render(str, len, out);
+    });
+  }
 }
\ No newline at end of file
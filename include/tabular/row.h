@@ -9,20 +9,13 @@ class Row {
 public:
   class Config {
   public:
-    explicit Config(bool& dirty_)
-      : dirty_(dirty_)
-    {
-    }
-
     void hasBottom(bool has)
     {
-      dirty_ = true;
-      hasBottom_ = has;
+      detail::assign(hasBottom_, has, gen_);
     }
     void vertical(Border::Part part)
     {
-      dirty_ = true;
-      vertical_ = std::move(part);
+      detail::assign(vertical_, std::move(part), gen_);
     }
 
     bool hasBottom() const { return hasBottom_; }
@@ -30,14 +23,15 @@ public:
 
     void reset()
     {
-      vertical_ = 0;
-      dirty_ = true;
+      vertical(0);
     }
 
   private:
     friend class Row;
 
-    bool& dirty_;
+    // the last change, see `detail::Generation`
+    detail::Generation gen_;
+
     bool hasBottom_ = true;
     Border::Part vertical_ = 0;
   };
@@ -45,17 +39,10 @@ public:
 public:
   Row() = default;
 
-  // copy contructor
-  // NOTE: it's mandatory to initialize config_ with dirty_ to avoid a heap-use-after-free error
-  // from the address sanitizer, then copy the members of the other.config_ into our new one
-  // See column.h:200 note
-  Row(const Row& other)
-    : columns_(other.columns_), dirty_(other.dirty_), str_(other.str_), 
-    config_(dirty_) // CRUCIAL
-  {
-    config_.hasBottom_ = other.config_.hasBottom_;
-    config_.vertical_ = other.config_.vertical_;
-  }
+  Row(const Row&) = default;
+  Row(Row&&) noexcept = default;
+  Row& operator=(const Row&) = default;
+  Row& operator=(Row&&) noexcept = default;
 
   explicit Row(std::vector<Column> columns)
     : columns_(std::move(columns))
@@ -73,23 +60,19 @@ public:
 
   void columns(std::vector<Column> columns)
   {
-    dirty_ = true;
+    gen_.bump();
     columns_ = std::move(columns);
   }
 
   Config& config() { return config_; }
   const Config& config() const { return config_; }
 
-  std::vector<Column>& columns()
-  {
-    dirty_ = true;
-    return columns_;
-  }
+  // the columns track their own changes, handing them out isn't a change
+  std::vector<Column>& columns() { return columns_; }
   const std::vector<Column>& columns() const { return columns_; }
 
   Column& column(int index)
   {
-    dirty_ = true;
     return columns_.at(index);
   }
   const Column& column(int index) const
@@ -99,7 +82,6 @@ public:
 
   Column& operator[](int index)
   {
-    dirty_ = true;
     return columns_.at(index);
   }
   const Column& operator[](int index) const
@@ -111,67 +93,148 @@ public:
   {
     columns_.clear();
     str_.clear();
+    strWidths_.clear();
+    strVertical_.clear();
     config_.reset();
-    dirty_ = false;
+    gen_.bump();
+    strGen_ = generation();
+  }
+
+  // changes whenever the row, its configuration or one of its columns
+  // changes
+  uint64_t generation() const
+  {
+    uint64_t generation = (std::max)(gen_, config_.gen_);
+
+    for (const auto& column : columns_)
+      generation = (std::max)(generation, column.generation());
+
+    return generation;
   }
 
   const std::string& str() const
   {
-    if (dirty_)
+    std::vector<size_t> widths;
+    widths.reserve(columns_.size());
+
+    for (const auto& column : columns_)
+      widths.push_back(column.config().width());
+
+    return str(widths, config().vertical());
+  }
+
+  // the row laid out with the given column widths and vertical border,
+  // instead of the columns' and the row's own configuration
+  const std::string& str(const std::vector<size_t>& widths,
+                         const Border::Part& vertical) const
+  {
+    const std::string& verticalStr = vertical.str();
+    if (!cached(widths, verticalStr))
     {
-      str_ = genStr();
-      dirty_ = false;
+      str_.clear();
+      genStr(str_, widths, verticalStr, true);
+      strWidths_ = widths;
+      strVertical_ = verticalStr;
+      strGen_ = generation();
     }
 
     return str_;
   }
 
+  // appends the row laid out like `str(widths, vertical)` to `out`, nothing
+  // is cached, neither the row nor the columns lines, unless it already is
+  void write(std::string& out, const std::vector<size_t>& widths,
+             const Border::Part& vertical) const
+  {
+    const std::string& verticalStr = vertical.str();
+
+    if (cached(widths, verticalStr)) out += str_;
+    else genStr(out, widths, verticalStr, false);
+  }
+
 private:
   // cache
-  mutable bool dirty_ = false;
   mutable std::string str_;
+  mutable uint64_t strGen_ = 0;
+
+  // the layout `str_` was generated with
+  mutable std::vector<size_t> strWidths_;
+  mutable std::string strVertical_;
+
+  // the last change of the columns, see `detail::Generation`
+  detail::Generation gen_;
 
   std::vector<Column> columns_;
-  Config config_{dirty_};
+  Config config_;
 
-  std::string genStr() const
+  bool cached(const std::vector<size_t>& widths,
+              const std::string& vertical) const
   {
-    if (columns_.empty()) return "";
-    const size_t maxLines = getMaxLines();
+    return strGen_ == generation() && widths == strWidths_ &&
+           vertical == strVertical_;
+  }
+
+  // appends the row to `rowStr`, the columns cache their lines only if
+  // `cache` is set
+  void genStr(std::string& rowStr, const std::vector<size_t>& widths,
+              const std::string& vertical, const bool cache) const
+  {
+    if (columns_.empty()) return;
+
+    // the lines of every column, the ones that aren't cached are kept here
+    std::vector<const std::vector<std::string>*> lines(columns_.size());
+    std::vector<std::vector<std::string>> uncached;
+    uncached.reserve(cache ? 0 : columns_.size());
+
+    size_t maxLines = 0;
+    for (size_t j = 0; j < columns_.size(); ++j)
+    {
+      const auto& column = columns_[j];
+
+      if (cache || column.cached(widths[j]))
+        lines[j] = &column.lines(widths[j]);
+      else
+      {
+        uncached.push_back(column.genLines(widths[j]));
+        lines[j] = &uncached.back();
+      }
+
+      maxLines = (std::max)(maxLines, lines[j]->size());
+    }
+
+    // the exact size (and a newline per line), the shorter columns are
+    // filled with empty lines
+    std::vector<std::string> empty(columns_.size());
+    size_t size = maxLines * ((columns_.size() + 1) * vertical.size() + 1);
 
-    std::string rowStr;
-    // average
-    rowStr.reserve(DEFAULT_WIDTH * maxLines + (columns_.size() + 1));
+    for (size_t j = 0; j < columns_.size(); ++j)
+    {
+      for (const auto& line : *lines[j])
+        size += line.size();
+
+      if (lines[j]->size() >= maxLines) continue;
+
+      empty[j] = columns_[j].genEmptyLine(widths[j]);
+      size += (maxLines - lines[j]->size()) * empty[j].size();
+    }
+
+    rowStr.reserve(rowStr.size() + size);
 
-    const auto& vertical = config().vertical().str();
     for (size_t i = 0; i < maxLines; ++i)
     {
-      if (!rowStr.empty()) rowStr.push_back('\n');
+      if (i > 0) rowStr.push_back('\n');
       rowStr.append(vertical);
 
-      for (const auto& column : columns_)
+      for (size_t j = 0; j < columns_.size(); ++j)
       {
-        const auto& lines = column.lines();
-
-        if (lines.size() > i)
-          rowStr.append(lines[i]);
+        if (lines[j]->size() > i)
+          rowStr.append((*lines[j])[i]);
         else
-          rowStr.append(column.genEmptyLine());
+          rowStr.append(empty[j]);
 
         rowStr.append(vertical);
       }
     }
-
-    return rowStr;
-  }
-  size_t getMaxLines() const
-  {
-    size_t maxLines = 0;
-
-    for (const auto& column : columns_)
-      maxLines = (std::max)(maxLines, column.lines().size());
-
-    return maxLines;
   }
 };
 // clang-format off
@@ -0,0 +1,195 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <limits>
+#include <numeric>
+#include <string>
+#include <vector>
+#include "global.h"
+#include "parallel.h"
+#include "row.h"
+#include "string_utils.h"
+
+namespace tabular {
+// clang-format off
+// a column to sort the rows by, see `Table::sort()`. the cells are compared
+// by their content without the escape sequences, either as text byte by
+// byte or as numbers. the cells that aren't numbers, or that the rows don't
+// have, go after the others in both orders
+class SortKey {
+public:
+  enum class Kind { Lexical, Numeric };
+
+  SortKey() = default;
+
+  static SortKey Lexical(const size_t column)
+  {
+    return SortKey(Kind::Lexical, column);
+  }
+  static SortKey Numeric(const size_t column)
+  {
+    return SortKey(Kind::Numeric, column);
+  }
+
+  SortKey& descending(const bool descending = true)
+  {
+    descending_ = descending;
+    return *this;
+  }
+
+  Kind kind() const { return kind_; }
+  size_t column() const { return column_; }
+  bool descending() const { return descending_; }
+
+private:
+  Kind kind_ = Kind::Lexical;
+  size_t column_ = 0;
+  bool descending_ = false;
+
+  SortKey(const Kind kind, const size_t column)
+    : kind_(kind), column_(column)
+  {
+  }
+};
+// clang-format on
+
+namespace detail {
+// the number in `str` (surrounded by spaces or not), or NaN if it isn't one
+inline double parseNumber(const std::string& str)
+{
+  const char* begin = str.c_str();
+  char* end = nullptr;
+
+  const double number = std::strtod(begin, &end);
+  if (end == begin) return std::numeric_limits<double>::quiet_NaN();
+
+  while (*end != '\0' && string_utils::isSpace(*end))
+    ++end;
+
+  return *end == '\0' ? number : std::numeric_limits<double>::quiet_NaN();
+}
+
+// sorts `indices` (of `rows`) by `keys`, the equal rows keep their order.
+// the key of every cell is extracted once, then the rows are sorted in
+// parts that are merged two by two, the parts and the merges are spread
+// over the executor or the threads
+inline void sortRows(const std::vector<Row>& rows, std::vector<size_t>& indices,
+                     const std::vector<SortKey>& keys, const Executor* executor,
+                     const size_t threads)
+{
+  const size_t size = indices.size();
+  if (size < 2 || keys.empty()) return;
+
+  const size_t tasks = (size + ROWS_PER_TASK - 1) / ROWS_PER_TASK;
+  const bool parallel = (executor != nullptr || threads > 1) && tasks > 1;
+
+  auto run = [&](const size_t count, const std::function<void(size_t)>& task) {
+    if (parallel) parallelFor(executor, threads, count, task);
+    else for (size_t i = 0; i < count; ++i) task(i);
+  };
+
+  // the keys of the rows at every position of `indices`, a single kind
+  // per sort key. a missing cell is an empty text, or not a number
+  std::vector<std::vector<std::string>> texts(keys.size());
+  std::vector<std::vector<double>> numbers(keys.size());
+
+  for (size_t k = 0; k < keys.size(); ++k)
+  {
+    if (keys[k].kind() == SortKey::Kind::Numeric)
+      numbers[k].assign(size, std::numeric_limits<double>::quiet_NaN());
+    else
+      texts[k].resize(size);
+  }
+
+  run(tasks, [&](const size_t task) {
+    const size_t first = task * ROWS_PER_TASK;
+    const size_t last = (std::min)(first + ROWS_PER_TASK, size);
+
+    for (size_t p = first; p < last; ++p)
+    {
+      const auto& columns = rows[indices[p]].columns();
+      for (size_t k = 0; k < keys.size(); ++k)
+      {
+        const size_t column = keys[k].column();
+        if (column >= columns.size()) continue;
+
+        std::string text = string_utils::stripEscapes(columns[column].content());
+        if (keys[k].kind() == SortKey::Kind::Numeric)
+          numbers[k][p] = parseNumber(text);
+        else
+          texts[k][p] = std::move(text);
+      }
+    }
+  });
+
+  // the non-numbers go last whatever the order
+  auto less = [&](const size_t a, const size_t b) {
+    for (size_t k = 0; k < keys.size(); ++k)
+    {
+      const bool descending = keys[k].descending();
+      if (keys[k].kind() == SortKey::Kind::Numeric)
+      {
+        const double x = numbers[k][a], y = numbers[k][b];
+        if (std::isnan(x) || std::isnan(y))
+        {
+          if (std::isnan(x) && std::isnan(y)) continue;
+          return std::isnan(y);
+        }
+
+        if (x != y) return descending ? y < x : x < y;
+      }
+
+      else
+      {
+        const int order = texts[k][a].compare(texts[k][b]);
+        if (order != 0) return descending ? order > 0 : order < 0;
+      }
+    }
+
+    return false;
+  };
+
+  std::vector<size_t> positions(size);
+  std::iota(positions.begin(), positions.end(), size_t(0));
+
+  if (!parallel)
+    std::stable_sort(positions.begin(), positions.end(), less);
+
+  else
+  {
+    run(tasks, [&](const size_t task) {
+      const size_t first = task * ROWS_PER_TASK;
+      const size_t last = (std::min)(first + ROWS_PER_TASK, size);
+      std::stable_sort(positions.begin() + first, positions.begin() + last, less);
+    });
+
+    // the sorted parts are merged two by two until there is one left, the
+    // left part goes first on equal rows
+    std::vector<size_t> merged(size);
+    for (size_t width = ROWS_PER_TASK; width < size; width *= 2)
+    {
+      const size_t pairs = (size + 2 * width - 1) / (2 * width);
+      run(pairs, [&](const size_t pair) {
+        const size_t first = pair * 2 * width;
+        const size_t middle = (std::min)(first + width, size);
+        const size_t last = (std::min)(first + 2 * width, size);
+
+        std::merge(positions.begin() + first, positions.begin() + middle,
+                   positions.begin() + middle, positions.begin() + last,
+                   merged.begin() + first, less);
+      });
+
+      positions.swap(merged);
+    }
+  }
+
+  std::vector<size_t> sorted(size);
+  for (size_t p = 0; p < size; ++p)
+    sorted[p] = indices[positions[p]];
+
+  indices = std::move(sorted);
+}
+} // namespace detail
+} // namespace tabular
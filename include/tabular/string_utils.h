@@ -1,8 +1,32 @@
 #pragma once
 
+#include "width_table.h"
+
+#include <algorithm>
 #include <cstdint>
+#include <cstring>
 #include <string>
 
+#if __cplusplus >= 201703L || (defined(_MSVC_LANG) && _MSVC_LANG >= 201703L)
+#include <string_view>
+#define TABULAR_HAS_STRING_VIEW
+#endif
+
+// vectorized ascii scanning, define TABULAR_NO_SIMD to force the scalar path
+#if !defined(TABULAR_NO_SIMD)
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define TABULAR_DETAIL_AVX2
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define TABULAR_DETAIL_SSE2
+#endif
+#endif
+
+#if defined(_MSC_VER) && (defined(TABULAR_DETAIL_AVX2) || defined(TABULAR_DETAIL_SSE2))
+#include <intrin.h>
+#endif
+
 namespace tabular {
 namespace detail {
 struct Range {
@@ -10,6 +34,8 @@ struct Range {
   uint32_t last;
 };
 
+// the source data of width_table.h, regenerate it after editing these ranges
+// Zero width characters (control, combining, format)
 constexpr static Range combining[] = {
     {0x0000, 0x001F}, {0x007F, 0x009F}, {0x0300, 0x036F}, {0x0483, 0x0489},
     {0x0591, 0x05BD}, {0x05BF, 0x05BF}, {0x05C1, 0x05C2}, {0x05C4, 0x05C5},
@@ -162,6 +188,69 @@ inline bool bisearch(uint32_t ucs, const Range* interval, int max)
 
   return false;
 }
+
+#if defined(TABULAR_DETAIL_AVX2) || defined(TABULAR_DETAIL_SSE2)
+// index of the lowest set bit, `mask` must not be 0
+inline unsigned ctz(const uint32_t mask)
+{
+#if defined(_MSC_VER)
+  unsigned long index;
+  _BitScanForward(&index, mask);
+  return static_cast<unsigned>(index);
+#else
+  return static_cast<unsigned>(__builtin_ctz(mask));
+#endif
+}
+#endif
+
+// returns the length of the leading run of printable ascii characters
+// (0x20 - 0x7E) in [begin, end), each one of them is exactly 1 column wide
+// so the caller can skip the whole run without decoding it
+inline size_t asciiRun(const char* begin, const char* end)
+{
+  const char* ptr = begin;
+
+#if defined(TABULAR_DETAIL_AVX2)
+  const __m256i low32 = _mm256_set1_epi8(0x1F);
+  const __m256i high32 = _mm256_set1_epi8(0x7F);
+
+  while (end - ptr >= 32)
+  {
+    const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(ptr));
+
+    // bytes >= 0x80 are negative as signed chars, so they fail the first test
+    const __m256i printable = _mm256_and_si256(_mm256_cmpgt_epi8(v, low32),
+                                               _mm256_cmpgt_epi8(high32, v));
+
+    const auto mask = static_cast<uint32_t>(_mm256_movemask_epi8(printable));
+    if (mask != 0xFFFFFFFFu) return static_cast<size_t>(ptr - begin) + ctz(~mask);
+
+    ptr += 32;
+  }
+#endif
+
+#if defined(TABULAR_DETAIL_AVX2) || defined(TABULAR_DETAIL_SSE2)
+  const __m128i low16 = _mm_set1_epi8(0x1F);
+  const __m128i high16 = _mm_set1_epi8(0x7F);
+
+  while (end - ptr >= 16)
+  {
+    const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(ptr));
+    const __m128i printable =
+        _mm_and_si128(_mm_cmpgt_epi8(v, low16), _mm_cmpgt_epi8(high16, v));
+
+    const auto mask = static_cast<uint32_t>(_mm_movemask_epi8(printable));
+    if (mask != 0xFFFFu) return static_cast<size_t>(ptr - begin) + ctz(~mask);
+
+    ptr += 16;
+  }
+#endif
+
+  while (ptr < end && *ptr >= 0x20 && *ptr < 0x7F)
+    ++ptr;
+
+  return static_cast<size_t>(ptr - begin);
+}
 }
 
 namespace string_utils {
@@ -181,9 +270,9 @@ constexpr bool isAlpha(const char character)
          (character >= 'a' && character <= 'z');
 }
 
-// convert a utf8 encoded sequence to a wide characters
-// returns true if it's a valid utf8 string
-inline bool utf8twc(const char* s, uint32_t& wc, int& consumed)
+// convert a utf8 encoded sequence of at most `len` bytes to a wide character
+// returns true if it's a valid utf8 sequence
+inline bool utf8twc(const char* s, const size_t len, uint32_t& wc, int& consumed)
 {
   const auto* u = reinterpret_cast<const unsigned char*>(s);
   const unsigned char c = u[0];
@@ -200,6 +289,9 @@ inline bool utf8twc(const char* s, uint32_t& wc, int& consumed)
   consumed = detail::utf8Len[c];
   if (consumed == 0) return false;
 
+  // truncated sequence
+  if (static_cast<size_t>(consumed) > len) return false;
+
   switch (consumed)
   {
   case 2:
@@ -224,54 +316,68 @@ inline bool utf8twc(const char* s, uint32_t& wc, int& consumed)
   }
 }
 
+// convert a NUL terminated utf8 encoded sequence to a wide characters
+// returns true if it's a valid utf8 string
+inline bool utf8twc(const char* s, uint32_t& wc, int& consumed)
+{
+  // the NUL terminator stops the sequence on its own
+  return utf8twc(s, 4, wc, consumed);
+}
+
 
 // return the display width of a Unicode character
+// NOTE: it's a two-stage table lookup, see scripts/width_table.py
 inline size_t wcwidth(const uint32_t ucs)
 {
   using namespace detail;
 
-  if (ucs == 0) return 0;
-  if (ucs < 32 || (ucs >= 0x7f && ucs < 0xa0)) return 0;
+  if (ucs >= widthTableEnd) return 1;
 
-  if (bisearch(ucs, combining,
-               (sizeof(combining) / sizeof(std::pair<uint32_t, uint32_t>)) - 1))
-    return 0;
+  const uint32_t block = widthStage1[ucs >> widthBlockBits];
+  const uint32_t offset = ucs & ((1u << widthBlockBits) - 1);
 
-  if (bisearch(ucs, wide,
-               (sizeof(wide) / sizeof(std::pair<uint32_t, uint32_t>)) - 1))
-    return 2;
-
-  return 1;
+  const uint8_t packed = widthStage2[(block << (widthBlockBits - 2)) | (offset >> 2)];
+  return (packed >> ((offset & 3) * 2)) & 3;
 }
 
-// calculates the display width of a given utf8 string
-inline size_t dw(const char* str)
+// calculates the display width of the first `len` bytes of a utf8 string
+inline size_t dw(const char* str, const size_t len)
 {
   using namespace detail;
 
   size_t width = 0;
   const char* ptr = str;
+  const char* end = str + len;
 
-  while (*ptr)
+  while (ptr < end)
   {
+    // printable ascii runs are measured in bulk
+    if (*ptr >= 0x20 && *ptr < 0x7F)
+    {
+      const size_t run = asciiRun(ptr, end);
+      width += run;
+      ptr += run;
+      continue;
+    }
+
     // skip ansi escape sequences
     if (*ptr == '\x1b')
     {
       // skip every ascii character until a non-ascii one
       // or an alphabet is found
       ++ptr;
-      while (*ptr && isAscii(*ptr) && !isAlpha(*ptr))
+      while (ptr < end && isAscii(*ptr) && !isAlpha(*ptr))
         ++ptr;
 
       // skip the first alphabet too
-      if (*ptr && isAlpha(*ptr)) ++ptr;
+      if (ptr < end && isAlpha(*ptr)) ++ptr;
       continue;
     }
 
     // UTF-8 characters
     uint32_t wc;
     int consumed = 1;
-    if (utf8twc(ptr, wc, consumed))
+    if (utf8twc(ptr, static_cast<size_t>(end - ptr), wc, consumed))
     {
       width += string_utils::wcwidth(wc);
       ptr += consumed;
@@ -288,45 +394,68 @@ inline size_t dw(const char* str)
   return width;
 }
 
+// calculates the display width of a given NUL terminated utf8 string
+inline size_t dw(const char* str)
+{
+  return dw(str, std::char_traits<char>::length(str));
+}
+
 inline size_t dw(const std::string& str)
 {
-  return dw(str.c_str());
+  return dw(str.data(), str.length());
 }
 
-inline std::string readUtf8Char(const std::string& str, const size_t pos)
+#ifdef TABULAR_HAS_STRING_VIEW
+inline size_t dw(const std::string_view str)
+{
+  return dw(str.data(), str.length());
+}
+#endif
+
+// returns the length of the utf8 sequence starting at `str[pos]`,
+// or 0 if it's invalid or truncated
+inline size_t utf8CharLen(const char* str, const size_t len, const size_t pos)
 {
-  if (pos >= str.length()) return "";
+  if (pos >= len) return 0;
 
   const auto first_byte = static_cast<unsigned char>(str[pos]);
 
   // if it's a continuation byte then it's invalid
-  if ((first_byte & 0xC0) == 0x80) return "";
+  if ((first_byte & 0xC0) == 0x80) return 0;
 
   // find the length of the sequence from the start byte
-  size_t len;
+  size_t charLen;
   if ((first_byte & 0x80) == 0)
-    len = 1;
+    charLen = 1;
   else if ((first_byte & 0xE0) == 0xC0)
-    len = 2;
+    charLen = 2;
   else if ((first_byte & 0xF0) == 0xE0)
-    len = 3;
+    charLen = 3;
   else if ((first_byte & 0xF8) == 0xF0)
-    len = 4;
+    charLen = 4;
   else
-    return "";
+    return 0;
 
   // not enough bytes
-  if (pos + len > str.length()) return "";
+  if (pos + charLen > len) return 0;
 
   // validate
-  for (size_t i = 1; i < len; ++i)
+  for (size_t i = 1; i < charLen; ++i)
   {
     if ((static_cast<unsigned char>(str[pos + i]) & 0xC0) != 0x80)
     {
-      return "";
+      return 0;
     }
   }
 
+  return charLen;
+}
+
+inline std::string readUtf8Char(const std::string& str, const size_t pos)
+{
+  const size_t len = utf8CharLen(str.data(), str.length(), pos);
+  if (len == 0) return "";
+
   return str.substr(pos, len);
 }
 
@@ -337,5 +466,55 @@ inline bool endsWith(const std::string& str, const std::string& with)
   if (n < len) return false;
   return str.compare(n - len, len, with) == 0;
 }
+
+// the string without its escape sequences, read the same way `dw` skips them
+inline std::string stripEscapes(const std::string& str)
+{
+  std::string stripped;
+  stripped.reserve(str.size());
+
+  const char* ptr = str.data();
+  const char* end = ptr + str.size();
+  while (ptr < end)
+  {
+    const char* escape = std::find(ptr, end, '\x1b');
+    stripped.append(ptr, escape);
+    if (escape == end) break;
+
+    ptr = escape + 1;
+    while (ptr < end && isAscii(*ptr) && !isAlpha(*ptr))
+      ++ptr;
+
+    if (ptr < end && isAlpha(*ptr)) ++ptr;
+  }
+
+  return stripped;
+}
+
+// appends `count` copies of the `len` bytes at `str`, the copied part is
+// doubled every time so it takes a few copies instead of one per repeat
+inline void repeat(std::string& out, const char* str, const size_t len,
+                   const size_t count)
+{
+  const size_t total = len * count;
+  if (total == 0) return;
+
+  const size_t start = out.size();
+  out.resize(start + total);
+
+  char* dst = &out[start];
+  std::memcpy(dst, str, len);
+
+  for (size_t filled = len; filled < total;)
+  {
+    const size_t n = (std::min)(filled, total - filled);
+    std::memcpy(dst + filled, dst, n);
+    filled += n;
+  }
+}
 }
-}
\ No newline at end of file
+}
+
+// the SIMD paths are an implementation detail
+#undef TABULAR_DETAIL_AVX2
+#undef TABULAR_DETAIL_SSE2
@@ -1,26 +1,146 @@
 #pragma once
 
+#include "column_width.h"
+#include "parallel.h"
 #include "row.h"
+#include "sort_key.h"
+
+#include <map>
+#include <memory>
+#include <numeric>
 #include <stdexcept>
 
 namespace tabular {
 
 namespace detail {
-inline bool bisearch(const std::vector<size_t>& vec, size_t value)
+// the widths the table assigns to the columns of each row, they are kept
+// apart from the rows so laying the table out never touches the cells
+struct Layout {
+  std::vector<std::vector<size_t>> widths;
+
+  // the generations of the rows, and the lengths of the header and every
+  // row's part of the output (the row and its bottom border), so a changed
+  // row can be spliced into the output
+  std::vector<uint64_t> generations;
+  std::vector<size_t> lengths;
+  size_t header = 0;
+
+  // the auto-fit widths the rows were laid out with
+  std::vector<std::vector<size_t>> fits;
+};
+
+// the widths of the columns sharing `available`, the ones with a non-zero
+// width in `widths` keep it. the others get the width that fits their
+// content (`maximum`) if they all fit, or else at least their longest word
+// (`minimum`) and the rest of the space relative to what they miss to fit,
+// so the table wraps as little as it can
+inline std::vector<size_t> fitWidths(std::vector<size_t> widths,
+                                     const std::vector<size_t>& minimum,
+                                     const std::vector<size_t>& maximum,
+                                     size_t available)
 {
-  size_t left = 0;
-  size_t right = vec.size();
+  const size_t columns = widths.size();
+  std::vector<bool> fixed(columns, false);
+
+  size_t fixedWidth = 0, unspecified = 0;
+  for (size_t i = 0; i < columns; ++i)
+  {
+    fixed[i] = widths[i] != 0;
+    if (fixed[i]) fixedWidth += widths[i];
+    else unspecified++;
+  }
+
+  // the fixed widths must leave enough space for the others, or fill the
+  // whole space if there are no others
+  if (unspecified == 0 ? fixedWidth != available
+                       : fixedWidth + unspecified * MIN_COLUMN_WIDTH > available)
+  {
+    fixed.assign(columns, false);
+    fixedWidth = 0;
+    unspecified = columns;
+  }
+
+  if (unspecified == 0) return widths;
+  available -= fixedWidth;
+
+  size_t minTotal = 0, maxTotal = 0;
+  for (size_t i = 0; i < columns; ++i)
+  {
+    if (fixed[i]) continue;
+    minTotal += minimum[i];
+    maxTotal += maximum[i];
+  }
+
+  size_t used = 0;
+
+  // nothing wraps
+  if (maxTotal <= available)
+  {
+    for (size_t i = 0; i < columns; ++i)
+    {
+      if (fixed[i]) continue;
+      widths[i] = maximum[i];
+      used += widths[i];
+    }
+  }
 
-  while (left < right)
+  // no word is broken, the columns that miss more get more
+  else if (minTotal <= available)
   {
-    size_t mid = left + (right - left) / 2;
+    const size_t space = available - minTotal;
+    const size_t missing = maxTotal - minTotal;
 
-    if (vec[mid] == value) return true;
+    for (size_t i = 0; i < columns; ++i)
+    {
+      if (fixed[i]) continue;
+      widths[i] = minimum[i] + (maximum[i] - minimum[i]) * space / missing;
+      used += widths[i];
+    }
+
+    // the rounding leftovers
+    for (size_t i = 0; used < available; i = (i + 1) % columns)
+    {
+      if (fixed[i] || widths[i] >= maximum[i]) continue;
+      widths[i]++;
+      used++;
+    }
+  }
 
-    if (vec[mid] < value) left = mid + 1;
-    else right = mid;
+  // the words are broken anyway, shrink the columns relative to each other
+  else
+  {
+    for (size_t i = 0; i < columns; ++i)
+    {
+      if (fixed[i]) continue;
+
+      const size_t w = minimum[i] * available / minTotal;
+      widths[i] = (std::max)(w, static_cast<size_t>(MIN_COLUMN_WIDTH));
+      used += widths[i];
+    }
+
+    while (used > available)
+    {
+      size_t widest = columns;
+      for (size_t i = 0; i < columns; ++i)
+      {
+        if (fixed[i]) continue;
+        if (widest == columns || widths[i] > widths[widest]) widest = i;
+      }
+
+      widths[widest]--;
+      used--;
+    }
+  }
+
+  // hand out the rest
+  for (size_t i = 0; used < available; i = (i + 1) % columns)
+  {
+    if (fixed[i]) continue;
+    widths[i]++;
+    used++;
   }
-  return false;
+
+  return widths;
 }
 }
 
@@ -29,88 +149,131 @@ class Table {
 public:
   class Config {
   public:
-    explicit Config(bool& dirty_) : dirty_(dirty_)
+    void width(const size_t width)
     {
+      detail::assign(width_, width, gen_);
     }
 
-    void width(const size_t width)
+    size_t width() const { return width_; }
+
+    // lays every row out with the same widths per number of columns, that
+    // fit the content of all the rows (see `detail::fitWidths()`), instead
+    // of sharing the table's width evenly between a row's columns
+    void autoFit(const bool fit)
     {
-      dirty_ = true;
-      width_ = width;
+      detail::assign(autoFit_, fit, gen_);
     }
+    bool autoFit() const { return autoFit_; }
 
-    size_t width() const { return width_; }
+    // the width of the columns at the same index in every row, resolved
+    // once for every number of columns instead of for every row. it takes
+    // over the columns' own widths and the auto-fit
+    void columns(std::vector<ColumnWidth> columns)
+    {
+      detail::assign(columns_, std::move(columns), gen_);
+    }
+    const std::vector<ColumnWidth>& columns() const { return columns_; }
+
+    // renders the rows on `count` threads, or on `executor` running up to
+    // `concurrency` tasks at once (as many as the hardware threads if 0), the
+    // output doesn't change, only the time it takes. a single thread by
+    // default
+    void threads(const size_t count) { threads_ = count; }
+    void executor(Executor executor, const size_t concurrency = 0)
+    {
+      executor_ = executor ? std::make_shared<Executor>(std::move(executor))
+                           : nullptr;
+      concurrency_ = concurrency > 0 ? concurrency
+                                     : std::thread::hardware_concurrency();
+    }
+
+    size_t threads() const { return threads_; }
+    bool parallel() const { return threads_ > 1 || executor_ != nullptr; }
 
     void reset()
     {
-      width_ = DEFAULT_WIDTH;
-      dirty_ = true;
+      width(DEFAULT_WIDTH);
+      autoFit(false);
+      columns({});
+      threads_ = 1;
+      executor_ = nullptr;
+      concurrency_ = 0;
     }
 
   private:
-    bool& dirty_;
+    friend class Table;
+
+    // the last change, see `detail::Generation`
+    detail::Generation gen_;
+
     size_t width_ = DEFAULT_WIDTH;
+    bool autoFit_ = false;
+    std::vector<ColumnWidth> columns_;
+
+    // how the rows are rendered, they don't change the output
+    size_t threads_ = 1;
+    std::shared_ptr<Executor> executor_;
+    size_t concurrency_ = 0;
   };
 
 public:
   Table() = default;
 
   explicit Table(std::vector<Row> rows, Border border = {})
-    : rows_(std::move(rows)), border_(std::move(border)), dirty_(true)
+    : rows_(std::move(rows)), border_(std::move(border))
   {
+    gen_.bump();
   }
 
+  Table(const Table&) = default;
+  Table(Table&&) noexcept = default;
+  Table& operator=(const Table&) = default;
+  Table& operator=(Table&&) noexcept = default;
+
   void rows(std::vector<Row> rows)
   {
     rows_ = std::move(rows);
-    dirty_ = true;
+    gen_.bump();
   }
   void border(Border border)
   {
     border_ = std::move(border);
-    dirty_ = true;
+    gen_.bump();
   }
 
   Table& addRow(Row row)
   {
     rows_.emplace_back(std::move(row));
-    dirty_ = true;
+    gen_.bump();
     return *this;
   }
   Table& addRow(std::vector<std::string> row)
   {
     rows_.emplace_back(std::move(row));
-    dirty_ = true;
+    gen_.bump();
     return *this;
   }
 
   Config& config() { return config_; }
   const Config& config() const { return config_; }
 
-  Border& border()
-  {
-    dirty_ = true;
-    return border_;
-  }
+  // the border and the rows track their own changes, handing them out isn't
+  // a change
+  Border& border() { return border_; }
   const Border& border() const { return border_; }
 
-  std::vector<Row>& rows()
-  {
-    dirty_ = true;
-    return rows_;
-  }
+  std::vector<Row>& rows() { return rows_; }
   const std::vector<Row>& rows() const { return rows_; }
 
+  // only the rows that changed are rendered again
   Row& row(int index)
   {
-    dirty_ = true;
     return rows_.at(index);
   }
   const Row& row(int index) const { return rows_.at(index); }
 
   Row& operator[](int index)
   {
-    dirty_ = true;
     return rows_.at(index);
   }
   const Row& operator[](int index) const
@@ -118,73 +281,577 @@ public:
     return rows_.at(index);
   }
 
+  // sorts the rows by the cells of `keys`, the first key first then the
+  // next one for the rows it finds equal, ... the equal rows keep their
+  // order and the rows before `first` (e.g. a header) stay in place. the
+  // keys are extracted once, the rows are sorted concurrently in parallel
+  // mode and moved to their places, their cached output goes with them
+  Table& sort(const std::vector<SortKey>& keys, const size_t first = 0)
+  {
+    if (first >= rows_.size()) return *this;
+
+    std::vector<size_t> indices(rows_.size() - first);
+    std::iota(indices.begin(), indices.end(), first);
+
+    sortRows(indices, keys);
+
+    std::vector<Row> rows;
+    rows.reserve(rows_.size());
+
+    for (size_t i = 0; i < first; ++i)
+      rows.push_back(std::move(rows_[i]));
+    for (const size_t i : indices)
+      rows.push_back(std::move(rows_[i]));
+
+    rows_ = std::move(rows);
+    gen_.bump();
+    return *this;
+  }
+
   void clr()
   {
     rows_.clear();
     config_.reset();
     border_.reset();
     str_.clear();
-    dirty_ = false;
+    layout_ = detail::Layout();
+    strGen_ = generation();
   }
 
   const std::string& str() const
   {
-    if (dirty_)
+    // the rows that changed are spliced into the output, unless the whole
+    // table changed
+    if (!current() || !update())
     {
       str_ = genStr();
-    dirty_ = false;
+      strGen_ = generation();
     }
 
     return str_;
   }
 
+  // the exact size of `str()` in bytes, e.g. to size a buffer up front.
+  // the rows are rendered (and cached) to measure them, but the table's
+  // string isn't built
+  size_t size() const
+  {
+    if (current() && update()) return str_.size();
+    if (rows_.empty()) return 0;
+
+    detail::Layout layout = genLayout();
+    return getBorderHeader(layout.widths.front()).size() + 1 + measure(layout) +
+           getBorderFooter(layout.widths.back()).size();
+  }
+
+  // writes the table to `sink` piece by piece, a header, a row with its
+  // bottom border, ... then the footer, instead of building it as a whole.
+  // `sink` is called as `sink(const char* data, size_t length)`, and the
+  // written output is the same as `str()`.
+  // NOTE: only one row is held in memory at a time, nothing is cached
+  template <typename Sink> void render(Sink&& sink) const
+  {
+    // the output is already there, bring it up to date
+    if (current())
+    {
+      const std::string& str = this->str();
+      if (!str.empty()) sink(str.data(), str.size());
+      return;
+    }
+
+    if (rows_.empty()) return;
+
+    checkWidth();
+    if (autoFit()) refreshFits();
+
+    if (config_.parallel()) return renderParallel(sink);
+    renderRows(sink, 0, rows_.size(), identity, false);
+  }
+
+  // writes the rows [first, last) the same way, as a table of their own with
+  // a header above the first one and a footer below the last one, e.g. for
+  // a pager. the columns keep their widths in the whole table so the pages
+  // line up, and only the rows of the window are rendered.
+  // NOTE: the auto-fit widths come from all the rows, they are computed
+  // again only if a row changed, but every row is checked for changes
+  template <typename Sink>
+  void render(Sink&& sink, const size_t first, size_t last) const
+  {
+    last = (std::min)(last, rows_.size());
+    if (first >= last) return;
+
+    for (size_t i = first; i < last; ++i)
+      checkWidth(i);
+
+    if (autoFit()) refreshFits();
+    renderRows(sink, first, last, identity, false);
+  }
+
+  // the string form of the rows [first, last), see `render()`
+  std::string str(const size_t first, const size_t last) const
+  {
+    std::string str;
+    render([&str](const char* data, const size_t length) { str.append(data, length); },
+           first, last);
+
+    return str;
+  }
+
 private:
+  // the writer and the virtual table lay their rows out and draw their
+  // borders the same way, the views render the table's rows in their order
+  friend class Writer;
+  friend class VirtualTable;
+  friend class TableView;
+
   // cache
-  mutable bool dirty_ = false;
   mutable std::string str_;
+  mutable uint64_t strGen_ = 0;
+
+  // the columns widths of the last render
+  mutable detail::Layout layout_;
+
+  // the auto-fit widths for every number of columns, and the state of the
+  // rows they were computed from, see `refreshFits()`
+  mutable std::vector<std::vector<size_t>> fits_;
+  mutable uint64_t fitsGen_ = 0;
+  mutable std::vector<std::pair<uint64_t, size_t>> fitsRows_;
+
+  // the separators for every pair of rows layouts, see `middle()`
+  mutable std::map<std::vector<size_t>,
+                   std::map<std::vector<size_t>, std::string>> middles_;
+  mutable size_t middlesCount_ = 0;
+  mutable uint64_t middlesGen_ = 0;
+
+  // the `Config::columns()` widths for every number of columns, and the
+  // configuration they were resolved with
+  mutable std::vector<std::vector<size_t>> resolved_;
+  mutable uint64_t resolvedGen_ = 0;
+
+  // the last change of the rows, see `detail::Generation`
+  detail::Generation gen_;
 
   std::vector<Row> rows_;
-  Config config_{dirty_};
+  Config config_;
   Border border_;
 
+  // changes whenever the table changes as a whole, the rows changes are
+  // tracked by the rows themselves
+  uint64_t generation() const
+  {
+    const uint64_t generation = (std::max)(gen_, config_.gen_);
+    return (std::max)(generation, border_.generation());
+  }
+
+  // the columns widths come from their content
+  bool autoFit() const
+  {
+    return config_.autoFit() && config_.columns().empty();
+  }
+
+  // the cached output only needs the changed rows to be rendered again,
+  // rows added or removed through `rows()` change the whole table
+  bool current() const
+  {
+    return strGen_ == generation() && layout_.generations.size() == rows_.size();
+  }
+
   std::string genStr() const
   {
-    // avoid reference
-    auto rows = rows_;
-    if (rows.empty()) return "";
+    if (rows_.empty())
+    {
+      layout_ = detail::Layout();
+      return "";
+    }
+
+    // lay the columns out, the cells keep their own configuration
+    detail::Layout layout = genLayout();
+
+    const std::string header = getBorderHeader(layout.widths.front());
+    const std::string footer = getBorderFooter(layout.widths.back());
+
+    // the rows are rendered to measure them, then copied into a string
+    // allocated once
+    const size_t size = header.size() + 1 + measure(layout) + footer.size();
 
     std::string tableStr;
-    tableStr.reserve(rows.size() * config_.width());
+    tableStr.reserve(size);
+
+    tableStr += header;
+    tableStr += '\n';
+    layout.header = tableStr.size();
+
+    for (size_t i = 0; i < rows_.size(); ++i)
+      appendRow(tableStr, layout, i, 0, true);
 
-    adjustWidth(rows);
-    configureRows(rows);
+    tableStr += footer;
 
-    tableStr += getBorderHeader(rows) + '\n';
+    layout_ = std::move(layout);
+    return tableStr;
+  }
+
+  // renders the rows (they cache their output) to record their generations
+  // and the lengths of their parts of the output, and returns the sum of
+  // the lengths. the rows are rendered concurrently in parallel mode
+  size_t measure(detail::Layout& layout) const
+  {
+    const size_t size = rows_.size();
+    layout.generations.resize(size);
+    layout.lengths.resize(size);
 
-    const size_t rowsSize = rows_.size();
-    for (size_t i = 0; i < rowsSize; ++i)
+    auto measureRows = [&](const size_t first, const size_t last) {
+      for (size_t i = first; i < last; ++i)
+      {
+        const Row& row = rows_[i];
+        const auto& widths = layout.widths[i];
+
+        size_t length = row.str(widths, vertical(row)).size() + 1;
+        if (i + 1 < size && row.config().hasBottom())
+          length += middle(widths, layout.widths[i + 1]).size() + 1;
+
+        layout.generations[i] = row.generation();
+        layout.lengths[i] = length;
+      }
+    };
+
+    const size_t tasks = (size + ROWS_PER_TASK - 1) / ROWS_PER_TASK;
+    if (!config_.parallel() || tasks <= 1)
+      measureRows(0, size);
+
+    else
     {
-      auto& row = rows[i];
+      prepare(layout, 0, size, 0);
+      detail::parallelFor(config_.executor_.get(), config_.threads_, tasks,
+                          [&](const size_t task) {
+        const size_t first = task * ROWS_PER_TASK;
+        measureRows(first, (std::min)(first + ROWS_PER_TASK, size));
+      });
+    }
 
-      tableStr += row.str() + '\n';
+    size_t length = 0;
+    for (const size_t l : layout.lengths)
+      length += l;
 
-      if (i + 1 < rowsSize && row.config().hasBottom())
-        tableStr += getBorderMiddle(rows, i) + '\n';
+    return length;
+  }
+
+  // caches the shared border parts and the separators of the rows
+  // [first, last) before the threads use them
+  void prepare(const detail::Layout& layout, const size_t first,
+               const size_t last, const size_t offset) const
+  {
+    warmBorder();
+    for (size_t i = first; i < last; ++i)
+    {
+      if (i + 1 < rows_.size() && rows_[i].config().hasBottom())
+        middle(layout.widths[i - offset], layout.widths[i + 1 - offset]);
     }
+  }
 
-    tableStr += getBorderFooter(rows);
-    return tableStr;
+  // appends the rows [first, last) with their bottom borders without
+  // caching them, the widths of row `i` are `layout.widths[i - offset]`.
+  // the rows are rendered concurrently in parallel mode, the output stays
+  // the same
+  void genRows(std::string& out, const detail::Layout& layout,
+               const size_t first, const size_t last,
+               const size_t offset) const
+  {
+    const size_t count = last - first;
+    const size_t tasks = (count + ROWS_PER_TASK - 1) / ROWS_PER_TASK;
+
+    if (!config_.parallel() || tasks <= 1)
+    {
+      for (size_t i = first; i < last; ++i)
+        appendRow(out, layout, i, offset, false);
+      return;
+    }
+
+    prepare(layout, first, last, offset);
+
+    std::vector<std::string> parts(tasks);
+    detail::parallelFor(config_.executor_.get(), config_.threads_, tasks,
+                        [&](const size_t task) {
+      const size_t begin = first + task * ROWS_PER_TASK;
+      const size_t end = (std::min)(begin + ROWS_PER_TASK, last);
+
+      for (size_t i = begin; i < end; ++i)
+        appendRow(parts[task], layout, i, offset, false);
+    });
+
+    size_t size = out.size();
+    for (const auto& part : parts)
+      size += part.size();
+
+    out.reserve(size);
+    for (auto& part : parts)
+    {
+      out += part;
+      std::string().swap(part);
+    }
   }
-  static size_t calculateWidth(const Row& row, size_t& unspecified)
+
+  // appends the row with its bottom border, and returns the appended length
+  size_t appendRow(std::string& out, const detail::Layout& layout,
+                   const size_t index, const size_t offset,
+                   const bool cache) const
   {
-    const auto& columns = row.columns();
-    if (columns.empty()) return 0;
-    size_t width = 0;
+    const size_t length = out.size();
+    const auto& row = rows_[index];
+    const auto& widths = layout.widths[index - offset];
 
-    for (const auto& column : columns)
+    if (cache) out += row.str(widths, vertical(row));
+    else row.write(out, widths, vertical(row));
+    out += '\n';
+
+    if (index + 1 < rows_.size() && row.config().hasBottom())
+    {
+      out += middle(widths, layout.widths[index + 1 - offset]);
+      out += '\n';
+    }
+
+    return out.size() - length;
+  }
+
+  static size_t identity(const size_t index) { return index; }
+
+  // sorts the indices of some rows, see `sort()`
+  void sortRows(std::vector<size_t>& indices,
+                const std::vector<SortKey>& keys) const
+  {
+    detail::sortRows(rows_, indices, keys, config_.executor_.get(),
+                     config_.threads_);
+  }
+
+  // streams the rows `index(first)` ... `index(last - 1)` one by one, they
+  // cache their output only if `cache`
+  template <typename Sink, typename Index>
+  void renderRows(Sink&& sink, const size_t first, const size_t last,
+                  Index index, const bool cache) const
+  {
+    std::string buffer;
+    std::vector<size_t> widths = genWidths(index(first));
+
+    buffer += getBorderHeader(widths);
+    buffer += '\n';
+
+    for (size_t i = first; i < last; ++i)
+    {
+      const auto& row = rows_[index(i)];
+      if (cache) buffer += row.str(widths, vertical(row));
+      else row.write(buffer, widths, vertical(row));
+      trimMiddles();
+
+      // the footer follows the last row
+      if (i + 1 >= last)
+      {
+        buffer += '\n';
+        buffer += getBorderFooter(widths);
+      }
+
+      else
+      {
+        std::vector<size_t> nextWidths = genWidths(index(i + 1));
+        buffer += '\n';
+
+        if (row.config().hasBottom())
+        {
+          buffer += middle(widths, nextWidths);
+          buffer += '\n';
+        }
+
+        widths = std::move(nextWidths);
+      }
+
+      sink(buffer.data(), buffer.size());
+      buffer.clear();
+    }
+  }
+
+  // streams the rows in batches rendered concurrently, nothing is cached
+  template <typename Sink> void renderParallel(Sink&& sink) const
+  {
+    // a few tasks per thread, the whole batch is held before it's written
+    const size_t threads = config_.executor_ ? config_.concurrency_ : config_.threads_;
+    const size_t batch = ROWS_PER_TASK * (std::max)(threads, size_t(1)) * 4;
+
+    std::string buffer;
+    detail::Layout layout;
+
+    for (size_t first = 0; first < rows_.size(); first += batch)
+    {
+      const size_t last = (std::min)(first + batch, rows_.size());
+      trimMiddles();
+
+      // the widths of the batch, and of the next row for the last border
+      layout.widths.clear();
+      for (size_t i = first; i < last + 1 && i < rows_.size(); ++i)
+        layout.widths.push_back(genWidths(i));
+
+
+      if (first == 0)
+      {
+        buffer += getBorderHeader(layout.widths.front());
+        buffer += '\n';
+      }
+
+      genRows(buffer, layout, first, last, first);
+
+      if (last == rows_.size())
+        buffer += getBorderFooter(layout.widths.back());
+
+      sink(buffer.data(), buffer.size());
+      buffer.clear();
+    }
+  }
+
+  // the separator between two rows laid out with `widths` and `nextWidths`,
+  // memoized since most rows share their layout
+  const std::string& middle(const std::vector<size_t>& widths,
+                            const std::vector<size_t>& nextWidths) const
+  {
+    const uint64_t generation = border_.generation();
+    if (middlesGen_ != generation)
+    {
+      middles_.clear();
+      middlesCount_ = 0;
+      middlesGen_ = generation;
+    }
+
+    // only looked up while rendering in parallel, see `genRows()`
+    auto row = middles_.find(widths);
+    if (row != middles_.end())
     {
-      size_t w = column.config().width();
+      auto it = row->second.find(nextWidths);
+      if (it != row->second.end()) return it->second;
+    }
+
+    middlesCount_++;
+    return middles_[widths]
+      .emplace(nextWidths, getBorderMiddle(widths, nextWidths))
+      .first->second;
+  }
+
+  // forgets the separators if there are too many of them, the references to
+  // them must not be used after that
+  void trimMiddles() const
+  {
+    if (middlesCount_ <= MAX_MEMOIZED_SEPARATORS) return;
+
+    middles_.clear();
+    middlesCount_ = 0;
+  }
+
+  void warmBorder() const
+  {
+    border_.horizontal().str();
+    border_.vertical().str();
+    border_.cornerTopLeft().str();
+    border_.cornerTopRight().str();
+    border_.cornerBottomLeft().str();
+    border_.cornerBottomRight().str();
+    border_.intersection().str();
+    border_.connectorLeft().str();
+    border_.connectorRight().str();
+    border_.connectorTop().str();
+    border_.connectorBottom().str();
+  }
+
+  // renders the rows that changed since the last `str()` again, with the
+  // borders around them if their widths changed, and splices them into the
+  // cached output. returns false if the whole table must be rendered again
+  bool update() const
+  {
+    trimMiddles();
+    const size_t size = rows_.size();
+
+    std::vector<size_t> changed;
+    for (size_t i = 0; i < size; ++i)
+    {
+      const Row& row = rows_[i];
+
+      if (row.generation() != layout_.generations[i] ||
+          row.columns().size() != layout_.widths[i].size())
+        changed.push_back(i);
+    }
+
+    if (changed.empty()) return true;
+
+    for (const size_t i : changed)
+      checkWidth(i);
+
+    // the changed content may change the widths of all the rows
+    if (autoFit())
+    {
+      refreshFits();
+      if (fits_ != layout_.fits) return false;
+    }
+
+    // the parts of the output to generate again
+    std::vector<bool> parts(size, false);
+    bool header = false, footer = false;
+
+    for (const size_t i : changed)
+    {
+      parts[i] = true;
+      layout_.generations[i] = rows_[i].generation();
+
+      std::vector<size_t> widths = genWidths(i);
+      if (widths == layout_.widths[i]) continue;
+
+      layout_.widths[i] = std::move(widths);
+
+      // the borders around the row
+      if (i > 0) parts[i - 1] = true;
+      if (i == 0) header = true;
+      if (i + 1 == size) footer = true;
+    }
+
+    std::vector<size_t> offsets(size + 1, layout_.header);
+    for (size_t i = 0; i < size; ++i)
+      offsets[i + 1] = offsets[i] + layout_.lengths[i];
 
+    // from the end to the start, so the offsets stay valid
+    if (footer)
+      str_.replace(offsets[size], std::string::npos,
+                   getBorderFooter(layout_.widths.back()));
+
+    std::string part;
+    for (size_t i = size; i-- > 0;)
+    {
+      if (!parts[i]) continue;
+
+      part.clear();
+      const size_t length = appendRow(part, layout_, i, 0, true);
+
+      str_.replace(offsets[i], layout_.lengths[i], part);
+      layout_.lengths[i] = length;
+    }
+
+    if (header)
+    {
+      part = getBorderHeader(layout_.widths.front());
+      part += '\n';
+
+      str_.replace(0, layout_.header, part);
+      layout_.header = part.size();
+    }
+
+    return true;
+  }
+
+  // the vertical border of a row, the table's one unless the row has its own
+  const Border::Part& vertical(const Row& row) const
+  {
+    const auto& vertical = row.config().vertical();
+    return vertical.glyph() == '\0' ? border_.vertical() : vertical;
+  }
+  static size_t calculateWidth(const std::vector<size_t>& widths,
+                               size_t& unspecified)
+  {
+    size_t width = 0;
+
+    for (const size_t w : widths)
+    {
       if (w == 0) unspecified++;
       else width += w;
     }
@@ -192,182 +859,335 @@ private:
     return width;
   }
 
-  static void setWidth(Row& row, size_t width)
+  static void setWidth(std::vector<size_t>& widths, size_t width)
   {
-    auto& columns = row.columns();
-
-    size_t indivWidth = width / columns.size();
-    size_t rest = width % columns.size();
+    size_t indivWidth = width / widths.size();
+    size_t rest = width % widths.size();
 
-    for (auto& column : columns)
+    for (auto& w : widths)
     {
-      column.config().width(indivWidth + (rest > 0));
+      w = indivWidth + (rest > 0);
       rest -= (rest > 0);
     }
 
     // if there's still a rest
-    if (rest > 0) columns.back().config().width(indivWidth + rest);
+    if (rest > 0) widths.back() = indivWidth + rest;
   }
 
-  static void setUnspecifiedWidth(Row& row, size_t unspecified, size_t width)
+  static void setUnspecifiedWidth(std::vector<size_t>& widths,
+                                  size_t unspecified, size_t width)
   {
-    std::vector<Column>& columns = row.columns();
-
     size_t indivWidth = width / unspecified;
     size_t rest = width % unspecified;
 
     size_t lastUnsp = 0;
-    for (size_t i = 0; i < columns.size(); ++i)
+    for (size_t i = 0; i < widths.size(); ++i)
     {
-      auto& column = columns[i];
-      if (column.config().width() != 0) continue;
+      auto& w = widths[i];
+      if (w != 0) continue;
 
-      column.config().width(indivWidth + (rest > 0));
+      w = indivWidth + (rest > 0);
       rest -= (rest > 0);
       lastUnsp = i;
     }
 
     // if there's still a rest
-    if (rest > 0) columns[lastUnsp].config().width(indivWidth + rest);
+    if (rest > 0) widths[lastUnsp] = indivWidth + rest;
+  }
+
+  detail::Layout genLayout() const
+  {
+    detail::Layout layout;
+    layout.widths.reserve(rows_.size());
+
+    trimMiddles();
+    checkWidth();
+    if (autoFit())
+    {
+      refreshFits();
+      layout.fits = fits_;
+    }
+
+    for (size_t i = 0; i < rows_.size(); ++i)
+      layout.widths.push_back(genWidths(i));
+
+    return layout;
   }
 
-  void adjustWidth(std::vector<Row>& rows) const
+  // computes the auto-fit widths again if a row changed since the last
+  // time. a changed row gets a new generation, and its number of columns is
+  // checked too since removing a column may leave the generation as it was
+  void refreshFits() const
   {
-    if (rows.empty()) return;
+    const uint64_t generation = this->generation();
 
-    size_t width = config_.width();
-    for (size_t i = 0; i < rows.size(); ++i)
+    bool current = generation == fitsGen_ && fitsRows_.size() == rows_.size();
+    for (size_t i = 0; i < rows_.size() && current; ++i)
     {
-      Row& row = rows[i];
+      current = fitsRows_[i].first == rows_[i].generation() &&
+                fitsRows_[i].second == rows_[i].columns().size();
+    }
+
+    if (current) return;
+
+    fits_ = genFits();
+    fitsGen_ = generation;
+
+    fitsRows_.clear();
+    fitsRows_.reserve(rows_.size());
+    for (const auto& row : rows_)
+      fitsRows_.emplace_back(row.generation(), row.columns().size());
+  }
 
-      // check the minimum width first
+  // the auto-fit widths for every number of columns, from the narrowest
+  // and the widest widths of the columns in all the rows. the columns with
+  // an explicit width in some row keep the largest one
+  std::vector<std::vector<size_t>> genFits() const
+  {
+    struct Fit {
+      std::vector<size_t> widths, minimum, maximum;
+    };
+    using Fits = std::vector<Fit>;
+
+    auto collect = [this](Fits& fits, const size_t first, const size_t last) {
+      for (size_t i = first; i < last; ++i)
       {
-        size_t minWidth = (row.columns().size() * (MIN_COLUMN_WIDTH + 1)) + 1;
-        if (minWidth > width)
+        const auto& columns = rows_[i].columns();
+        if (fits.size() <= columns.size()) fits.resize(columns.size() + 1);
+
+        Fit& fit = fits[columns.size()];
+        if (fit.widths.empty())
         {
-          throw std::runtime_error(
-            "layout error: row " + std::to_string(i) +
-            " must a minimum width of " + std::to_string(minWidth) +
-            ", but found " + std::to_string(width));
+          fit.widths.assign(columns.size(), 0);
+          fit.minimum.assign(columns.size(), MIN_COLUMN_WIDTH);
+          fit.maximum.assign(columns.size(), MIN_COLUMN_WIDTH);
+        }
+
+        for (size_t j = 0; j < columns.size(); ++j)
+        {
+          const Column& column = columns[j];
+          fit.widths[j] = (std::max)(fit.widths[j], column.config().width());
+          fit.minimum[j] = (std::max)(fit.minimum[j], column.minWidth());
+          fit.maximum[j] = (std::max)(fit.maximum[j], column.maxWidth());
         }
       }
+    };
 
-      const size_t estimatedWidth = width - (row.columns().size() + 1);
+    const size_t size = rows_.size();
+    const size_t tasks = (size + ROWS_PER_TASK - 1) / ROWS_PER_TASK;
 
-      size_t unspecified = 0;
-      const size_t rowWidth = calculateWidth(row, unspecified);
+    Fits fits;
+    if (!config_.parallel() || tasks <= 1)
+      collect(fits, 0, size);
 
-      // everything is fine skip
-      if (rowWidth == estimatedWidth && unspecified == 0)
-        continue;
+    // the columns are measured concurrently, then merged
+    else
+    {
+      std::vector<Fits> parts(tasks);
+      detail::parallelFor(config_.executor_.get(), config_.threads_, tasks,
+                          [&](const size_t task) {
+        const size_t first = task * ROWS_PER_TASK;
+        collect(parts[task], first, (std::min)(first + ROWS_PER_TASK, size));
+      });
+
+      for (const Fits& part : parts)
+      {
+        if (fits.size() < part.size()) fits.resize(part.size());
 
-      // set just the unspecified columns widths
-      if (rowWidth < estimatedWidth && unspecified != 0)
-        setUnspecifiedWidth(row, unspecified, estimatedWidth - rowWidth);
+        for (size_t k = 0; k < part.size(); ++k)
+        {
+          if (part[k].widths.empty()) continue;
+          if (fits[k].widths.empty())
+          {
+            fits[k] = part[k];
+            continue;
+          }
+
+          for (size_t j = 0; j < k; ++j)
+          {
+            fits[k].widths[j] = (std::max)(fits[k].widths[j], part[k].widths[j]);
+            fits[k].minimum[j] = (std::max)(fits[k].minimum[j], part[k].minimum[j]);
+            fits[k].maximum[j] = (std::max)(fits[k].maximum[j], part[k].maximum[j]);
+          }
+        }
+      }
+    }
 
-      // set/restore the width of all the columns
-      else
-        setWidth(row, estimatedWidth);
+    std::vector<std::vector<size_t>> widths(fits.size());
+    for (size_t k = 1; k < fits.size(); ++k)
+    {
+      if (fits[k].widths.empty()) continue;
+
+      const size_t available = config_.width() - (k + 1);
+      widths[k] = detail::fitWidths(std::move(fits[k].widths), fits[k].minimum,
+                                    fits[k].maximum, available);
     }
+
+    return widths;
+  }
+
+  // throws if a row can't fit in the table's width
+  void checkWidth() const
+  {
+    for (size_t i = 0; i < rows_.size(); ++i)
+      checkWidth(i);
   }
-  void configureRows(std::vector<Row>& rows) const
+  void checkWidth(const size_t index) const
   {
-    auto& verticalBorder = border_.vertical();
-    for (auto& row : rows)
+    const size_t width = config_.width();
+    const size_t columns = rows_[index].columns().size();
+
+    size_t minWidth = (columns * (MIN_COLUMN_WIDTH + 1)) + 1;
+    if (minWidth > width)
     {
-      auto& config = row.config();
+      throw std::runtime_error(
+        "layout error: row " + std::to_string(index) +
+        " must a minimum width of " + std::to_string(minWidth) +
+        ", but found " + std::to_string(width));
+    }
+  }
+
+  // the columns widths of a row, they only depend on the row itself unless
+  // the table auto-fits its columns
+  std::vector<size_t> genWidths(const size_t index) const
+  {
+    const auto& columns = rows_[index].columns();
+    if (columns.empty()) return {};
 
-      if (config.vertical().glyph() == '\0')
-        config.vertical(verticalBorder);
+    if (!config_.columns().empty()) return resolveWidths(columns.size());
+    if (config_.autoFit())
+    {
+      // `refreshFits()` is called before the rows are laid out
+      if (columns.size() >= fits_.size() || fits_[columns.size()].size() != columns.size())
+        throw std::logic_error("layout error: the auto-fit widths are out of date");
+
+      return fits_[columns.size()];
     }
+
+    // start with the widths the columns asked for
+    std::vector<size_t> widths;
+    widths.reserve(columns.size());
+
+    for (const auto& column : columns)
+      widths.push_back(column.config().width());
+
+    if (widths.empty()) return widths;
+
+    const size_t estimatedWidth = config_.width() - (columns.size() + 1);
+
+    size_t unspecified = 0;
+    const size_t rowWidth = calculateWidth(widths, unspecified);
+
+    // everything is fine skip
+    if (rowWidth == estimatedWidth && unspecified == 0)
+      return widths;
+
+    // set just the unspecified columns widths
+    if (rowWidth < estimatedWidth && unspecified != 0)
+      setUnspecifiedWidth(widths, unspecified, estimatedWidth - rowWidth);
+
+    // set/restore the width of all the columns
+    else
+      setWidth(widths, estimatedWidth);
+
+    return widths;
   }
 
-  static std::vector<size_t> connections(const Row& row)
+  // the `Config::columns()` widths of the rows with `columns` columns
+  const std::vector<size_t>& resolveWidths(const size_t columns) const
   {
-    std::vector<size_t> connections;
-    connections.reserve(row.columns().size());
+    if (resolvedGen_ != config_.gen_)
+    {
+      resolved_.clear();
+      resolvedGen_ = config_.gen_;
+    }
 
-    size_t track = 1;
-    for (const Column& column : row.columns())
+    if (resolved_.size() <= columns) resolved_.resize(columns + 1);
+
+    auto& widths = resolved_[columns];
+    if (widths.empty())
     {
-      track += column.config().width();
-      connections.push_back(track++);
+      const size_t available = config_.width() - (columns + 1);
+      widths = detail::resolveWidths(config_.columns(), columns, available);
     }
 
-    return connections;
+    return widths;
   }
-  std::string getBorderHeader(std::vector<Row>& rows) const
+
+  // appends `count` horizontal glyphs
+  void fill(std::string& out, const size_t count) const
   {
-    const auto& columns = rows[0].columns();
+    border_.horizontal().fill(out, count);
+  }
 
+  std::string getBorderHeader(const std::vector<size_t>& widths) const
+  {
     std::string header = border_.cornerTopLeft().str();
     header.reserve(config_.width());
 
-    const std::string& horizontal = border_.horizontal().str();
-    for (size_t i = 0; i < columns.size(); ++i)
+    for (size_t i = 0; i < widths.size(); ++i)
     {
-      size_t width = columns[i].config().width();
+      fill(header, widths[i]);
 
-      for (size_t j = 0; j < width; ++j)
-        header += horizontal;
-
-      if (i + 1 < columns.size()) header += border_.connectorTop().str();
+      if (i + 1 < widths.size()) header += border_.connectorTop().str();
     }
 
     header += border_.cornerTopRight().str();
     return header;
   }
-  std::string getBorderFooter(std::vector<Row>& rows) const
+  std::string getBorderFooter(const std::vector<size_t>& widths) const
   {
-    const auto& columns = rows.back().columns();
-
     std::string footer = border_.cornerBottomLeft().str();
     footer.reserve(config_.width());
 
-    const std::string& horizontal = border_.horizontal().str();
-    for (size_t i = 0; i < columns.size(); ++i)
+    for (size_t i = 0; i < widths.size(); ++i)
     {
-      size_t width = columns[i].config().width();
-
-      for (size_t j = 0; j < width; ++j)
-        footer += horizontal;
+      fill(footer, widths[i]);
 
-      if (i + 1 < columns.size()) footer += border_.connectorBottom().str();
+      if (i + 1 < widths.size()) footer += border_.connectorBottom().str();
     }
 
     footer += border_.cornerBottomRight().str();
     return footer;
   }
-  std::string getBorderMiddle(std::vector<Row>& rows, size_t index) const
-  {
-    const auto nextRowConnections = connections(rows[index + 1]);
 
+  // merges the columns boundaries of the two rows, the boundaries of the
+  // row above are either intersections or bottom connectors, and the ones
+  // of the row below that fall in between are top connectors
+  std::string getBorderMiddle(const std::vector<size_t>& widths,
+                              const std::vector<size_t>& nextWidths) const
+  {
     std::string middle = border_.connectorLeft().str();
     middle.reserve(config_.width());
 
-    const auto& columns = rows[index].columns();
+    // the positions of the boundaries, the left corner is at 0
+    size_t position = 0, next = 0, j = 0;
+    if (!nextWidths.empty()) next = nextWidths[0] + 1;
 
-    size_t tracker = 0;
-    const std::string& horizontal = border_.horizontal().str();
-    for (size_t i = 0; i < columns.size(); ++i)
+    for (size_t i = 0; i < widths.size(); ++i)
     {
-      size_t width = columns[i].config().width();
+      const size_t boundary = position + widths[i] + 1;
 
-      for (size_t j = 0; j < width; ++j)
+      // the boundaries of the row below inside this column
+      while (j < nextWidths.size() && next < boundary)
       {
-        if (detail::bisearch(nextRowConnections, ++tracker))
-          middle += border_.connectorTop().str();
-        else
-          middle += horizontal;
+        fill(middle, next - position - 1);
+        middle += border_.connectorTop().str();
+        position = next;
+
+        if (++j < nextWidths.size()) next += nextWidths[j] + 1;
       }
-      tracker++;
 
-      if (i + 1 >= columns.size()) continue;
+      fill(middle, boundary - position - 1);
+      position = boundary;
 
-      if (detail::bisearch(nextRowConnections, tracker))
-        middle += border_.intersection().str();
-      else
-        middle += border_.connectorBottom().str();
+      const bool shared = j < nextWidths.size() && next == boundary;
+      if (shared && ++j < nextWidths.size()) next += nextWidths[j] + 1;
+
+      if (i + 1 >= widths.size()) continue;
+
+      if (shared) middle += border_.intersection().str();
+      else middle += border_.connectorBottom().str();
     }
 
     middle += border_.connectorRight().str();
@@ -0,0 +1,121 @@
+#pragma once
+
+#include "render.h"
+
+#include <algorithm>
+#include <numeric>
+
+namespace tabular {
+// clang-format off
+// the rows of a table in another order, or some of them, without copying
+// them: only their indices are kept, sorted and filtered. the view is
+// rendered like the table, the columns keep their widths in the whole table
+// and the rows reuse their cached output.
+// NOTE: the table must outlive the view, and the view must be reset if
+// rows are removed from the table
+class TableView {
+public:
+  explicit TableView(const Table& table)
+    : table_(&table)
+  {
+    reset();
+  }
+
+  // every row in the table's order
+  TableView& reset()
+  {
+    indices_.resize(table_->rows().size());
+    std::iota(indices_.begin(), indices_.end(), size_t(0));
+    return *this;
+  }
+
+  // orders the rows with `less(const Row&, const Row&)`, the equal rows
+  // keep their order
+  template <typename Less> TableView& sort(Less less)
+  {
+    const auto& rows = table_->rows();
+    std::stable_sort(indices_.begin(), indices_.end(),
+                     [&](const size_t a, const size_t b) { return less(rows[a], rows[b]); });
+
+    return *this;
+  }
+
+  // orders the rows by the cells of `keys`, see `Table::sort()`
+  TableView& sort(const std::vector<SortKey>& keys)
+  {
+    table_->sortRows(indices_, keys);
+    return *this;
+  }
+
+  // keeps the rows for which `keep(const Row&)` is true
+  template <typename Predicate> TableView& filter(Predicate keep)
+  {
+    const auto& rows = table_->rows();
+    indices_.erase(std::remove_if(indices_.begin(), indices_.end(),
+                                  [&](const size_t i) { return !keep(rows[i]); }),
+                   indices_.end());
+
+    return *this;
+  }
+
+  // the indices of the rows in the table, in the view's order
+  const std::vector<size_t>& indices() const { return indices_; }
+  size_t size() const { return indices_.size(); }
+
+  const Row& operator[](const size_t index) const
+  {
+    return table_->rows().at(indices_.at(index));
+  }
+
+  // writes the rows of the view to `sink`, see `Table::render()`
+  template <typename Sink> void render(Sink&& sink) const
+  {
+    render(sink, 0, indices_.size());
+  }
+
+  // writes the rows [first, last) of the view as a table of their own
+  template <typename Sink>
+  void render(Sink&& sink, const size_t first, size_t last) const
+  {
+    last = (std::min)(last, indices_.size());
+    if (first >= last) return;
+
+    for (size_t i = first; i < last; ++i)
+    {
+      if (indices_[i] >= table_->rows().size())
+        throw std::out_of_range("the view has rows that don't exist");
+
+      table_->checkWidth(indices_[i]);
+    }
+
+    if (table_->autoFit()) table_->refreshFits();
+
+    const std::vector<size_t>& indices = indices_;
+    table_->renderRows(sink, first, last,
+                       [&indices](const size_t i) { return indices[i]; }, true);
+  }
+
+  std::string str() const { return str(0, indices_.size()); }
+  std::string str(const size_t first, const size_t last) const
+  {
+    std::string str;
+    render([&str](const char* data, const size_t length) { str.append(data, length); },
+           first, last);
+
+    return str;
+  }
+
+private:
+  const Table* table_;
+  std::vector<size_t> indices_;
+};
+// clang-format on
+
+// streams the view into `out` row by row
+inline void render(const TableView& view, FILE* out)
+{
+  view.render([out](const char* str, const size_t len) {
+    render(str, len, out);
+  });
+}
+} // namespace tabular
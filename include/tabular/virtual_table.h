@@ -0,0 +1,204 @@
+#pragma once
+
+#include "render.h"
+
+namespace tabular {
+// clang-format off
+// the cells of a virtual table, e.g. behind a database cursor or a memory
+// mapped file. they are pulled one by one while the table is rendered
+class Source {
+public:
+  virtual ~Source() = default;
+
+  virtual size_t rows() const = 0;
+  virtual size_t columns() const = 0;
+
+  // sets the content of the cell at `row`, `column` and, optionally, its
+  // style and configuration. `cell` is reused from one cell to the next,
+  // it's cleared before every call
+  virtual void cell(size_t row, size_t column, Column& cell) const = 0;
+
+  // raises `width`, `minimum` and `maximum` to the largest explicit width,
+  // `Column::minWidth()` and `Column::maxWidth()` of the cells of `column`,
+  // e.g. for a source that can go through a column faster than through the
+  // rows. returns false to have the cells pulled row by row instead
+  virtual bool measure(size_t /* column */, size_t& /* width */,
+                       size_t& /* minimum */, size_t& /* maximum */) const
+  {
+    return false;
+  }
+};
+
+// a table whose rows aren't kept, every row is pulled from the source,
+// wrapped, written to the sink then dropped, so there is no object per cell.
+// the columns have the same widths in every row, either explicitly with
+// `widths()`, from `config().columns()`, from the content of all the cells
+// with `config().autoFit()`, or shared evenly.
+// NOTE: the source must outlive the table
+class VirtualTable {
+public:
+  explicit VirtualTable(const Source& source, Border border = {})
+    : source_(&source)
+  {
+    table_.border(std::move(border));
+  }
+
+  // the table's width, columns widths and border
+  Table::Config& config() { return table_.config(); }
+  const Table::Config& config() const { return table_.config(); }
+
+  Border& border() { return table_.border(); }
+  const Border& border() const { return table_.border(); }
+
+  // fixes the columns widths, instead of computing them on every render
+  VirtualTable& widths(std::vector<size_t> widths)
+  {
+    widths_ = std::move(widths);
+    return *this;
+  }
+
+  const std::vector<size_t>& widths() const { return widths_; }
+
+  // writes the table to `sink` row by row, see `Table::render()`
+  template <typename Sink> void render(Sink&& sink) const
+  {
+    render(sink, 0, source_->rows());
+  }
+
+  // writes the rows [first, last) as a table of their own, the columns
+  // keep the widths they have in the whole table
+  template <typename Sink>
+  void render(Sink&& sink, const size_t first, size_t last) const
+  {
+    last = (std::min)(last, source_->rows());
+    if (first >= last) return;
+
+    const size_t columns = source_->columns();
+    if (columns == 0) return;
+
+    const std::vector<size_t> widths = genWidths(columns);
+    if (widths.size() != columns)
+    {
+      throw std::runtime_error(
+        "layout error: the source has " + std::to_string(columns) +
+        " columns, but the layout has " + std::to_string(widths.size()));
+    }
+
+    const Border::Part& vertical = table_.border().vertical();
+    const std::string middle = table_.getBorderMiddle(widths, widths);
+
+    // the cells are reused from one row to the next
+    Row row{std::vector<Column>(columns)};
+
+    std::string buffer;
+    buffer += table_.getBorderHeader(widths);
+    buffer += '\n';
+
+    for (size_t i = first; i < last; ++i)
+    {
+      pull(row, i);
+      row.write(buffer, widths, vertical);
+      buffer += '\n';
+
+      // the footer follows the last row
+      if (i + 1 >= last)
+        buffer += table_.getBorderFooter(widths);
+
+      else
+      {
+        buffer += middle;
+        buffer += '\n';
+      }
+
+      sink(buffer.data(), buffer.size());
+      buffer.clear();
+    }
+  }
+
+  std::string str() const { return str(0, source_->rows()); }
+  std::string str(const size_t first, const size_t last) const
+  {
+    std::string str;
+    render([&str](const char* data, const size_t length) { str.append(data, length); },
+           first, last);
+
+    return str;
+  }
+
+private:
+  const Source* source_;
+
+  // configuration and border
+  Table table_;
+
+  std::vector<size_t> widths_;
+
+  void pull(Row& row, const size_t index) const
+  {
+    auto& cells = row.columns();
+    for (size_t j = 0; j < cells.size(); ++j)
+    {
+      cells[j].clr();
+      source_->cell(index, j, cells[j]);
+    }
+  }
+
+  // the columns widths, the same for every row. auto-fitting pulls every
+  // cell once to measure it, see `detail::fitWidths()`
+  std::vector<size_t> genWidths(const size_t columns) const
+  {
+    if (!widths_.empty()) return widths_;
+
+    const size_t width = config().width();
+    size_t minWidth = (columns * (MIN_COLUMN_WIDTH + 1)) + 1;
+    if (minWidth > width)
+    {
+      throw std::runtime_error(
+        "layout error: the rows must have a minimum width of " +
+        std::to_string(minWidth) + ", but found " + std::to_string(width));
+    }
+
+    if (!config().columns().empty()) return table_.resolveWidths(columns);
+
+    std::vector<size_t> widths(columns, 0);
+    if (!config().autoFit())
+    {
+      Table::setWidth(widths, width - (columns + 1));
+      return widths;
+    }
+
+    std::vector<size_t> minimum(columns, MIN_COLUMN_WIDTH);
+    std::vector<size_t> maximum(columns, MIN_COLUMN_WIDTH);
+
+    bool measured = true;
+    for (size_t j = 0; j < columns && measured; ++j)
+      measured = source_->measure(j, widths[j], minimum[j], maximum[j]);
+
+    Row row{std::vector<Column>(columns)};
+    for (size_t i = 0; i < source_->rows() && !measured; ++i)
+    {
+      pull(row, i);
+
+      const auto& cells = row.columns();
+      for (size_t j = 0; j < columns; ++j)
+      {
+        widths[j] = (std::max)(widths[j], cells[j].config().width());
+        minimum[j] = (std::max)(minimum[j], cells[j].minWidth());
+        maximum[j] = (std::max)(maximum[j], cells[j].maxWidth());
+      }
+    }
+
+    return detail::fitWidths(std::move(widths), minimum, maximum,
+                             width - (columns + 1));
+  }
+};
+// clang-format on
+
+// streams the virtual table into `out` row by row
+inline void render(const VirtualTable& table, FILE* out)
+{
+  table.render([out](const char* str, const size_t len) {
+    render(str, len, out);
+  });
+}
+} // namespace tabular
@@ -0,0 +1,281 @@
+#pragma once
+
+#include "render.h"
+
+#include <functional>
+
+namespace tabular {
+// clang-format off
+// writes a table row by row as the rows arrive, e.g. for live logs.
+// the columns layout is fixed up front, either explicitly with `widths()`
+// or from the first rows (see `sample()`), then the top border is written
+// once, every row as soon as it's added, and the bottom border on close.
+// NOTE: the rows aren't kept, the memory doesn't grow with their number
+class Writer {
+public:
+  using Sink = std::function<void(const char*, size_t)>;
+
+  explicit Writer(Sink sink, Border border = {})
+    : sink_(std::move(sink))
+  {
+    table_.border(std::move(border));
+  }
+  explicit Writer(FILE* out, Border border = {})
+    : Writer([out](const char* str, const size_t len) { render(str, len, out); },
+             std::move(border))
+  {
+  }
+
+  Writer(const Writer&) = delete;
+  Writer& operator=(const Writer&) = delete;
+
+  ~Writer()
+  {
+    // the destructor must not throw, call `close()` to handle the errors
+    try
+    {
+      close();
+    }
+    catch (...)
+    {
+    }
+  }
+
+  // the table's width and border, the changes made after the first row is
+  // written are ignored
+  Table::Config& config() { return table_.config(); }
+  const Table::Config& config() const { return table_.config(); }
+
+  Border& border() { return table_.border(); }
+  const Border& border() const { return table_.border(); }
+
+  // fixes the columns widths, every row must have as many columns. they
+  // can't be changed once the first row is written
+  Writer& widths(std::vector<size_t> widths)
+  {
+    checkStarted();
+    widths_ = std::move(widths);
+    return *this;
+  }
+
+  // lays the columns out from the first `count` rows, they are held back
+  // until then (or until `close()`)
+  Writer& sample(const size_t count)
+  {
+    sample_ = count > 0 ? count : 1;
+    return *this;
+  }
+
+  const std::vector<size_t>& widths() const { return widths_; }
+
+  Writer& addRow(Row row)
+  {
+    if (closed_) throw std::logic_error("writer error: the writer is closed");
+
+    // the table's columns widths don't need the content
+    if (widths_.empty() && !table_.config().columns().empty())
+    {
+      checkWidth(row.columns().size());
+      widths_ = table_.resolveWidths(row.columns().size());
+    }
+
+    if (widths_.empty())
+    {
+      sampled_.emplace_back(std::move(row));
+      if (sampled_.size() >= sample_) flushSampled();
+
+      return *this;
+    }
+
+    write(row);
+    return *this;
+  }
+  Writer& addRow(std::vector<std::string> row)
+  {
+    return addRow(Row(std::move(row)));
+  }
+
+  // writes the held back rows and the bottom border, rows can't be added
+  // after that
+  void close()
+  {
+    if (closed_) return;
+
+    flushSampled();
+    finish();
+  }
+
+private:
+  Sink sink_;
+
+  // configuration and border
+  Table table_;
+
+  // the columns layout and the rows held back to compute it
+  std::vector<size_t> widths_;
+  std::vector<Row> sampled_;
+  size_t sample_ = 1;
+
+  // the border as it was when the first row was written, and the memoized
+  // separator between two rows and bottom border
+  Border border_;
+  std::string middle_;
+  std::string footer_;
+
+  // the last written row wants a bottom border
+  bool hasBottom_ = false;
+  bool started_ = false;
+  bool closed_ = false;
+
+  std::string buffer_;
+
+  // a held back row that doesn't fit the layout closes the writer, the rows
+  // after it are dropped so none of them is written twice
+  void flushSampled()
+  {
+    if (sampled_.empty()) return;
+
+    std::vector<Row> rows = std::move(sampled_);
+    sampled_.clear();
+    sampled_.shrink_to_fit();
+
+    try
+    {
+      if (widths_.empty()) widths_ = sampleWidths(rows);
+
+      for (const auto& row : rows)
+        write(row);
+    }
+    catch (...)
+    {
+      finish();
+      throw;
+    }
+  }
+
+  // writes the bottom border, rows can't be added after that
+  void finish()
+  {
+    if (closed_) return;
+    closed_ = true;
+
+    if (started_) sink_(footer_.data(), footer_.size());
+  }
+
+  void write(const Row& row)
+  {
+    const size_t columns = row.columns().size();
+    if (columns != widths_.size())
+    {
+      throw std::runtime_error(
+        "layout error: the row has " + std::to_string(columns) +
+        " columns, but the layout has " + std::to_string(widths_.size()));
+    }
+
+    buffer_.clear();
+
+    if (!started_)
+    {
+      checkWidths();
+      buffer_ += table_.getBorderHeader(widths_);
+      buffer_ += '\n';
+      middle_ = table_.getBorderMiddle(widths_, widths_);
+      footer_ = table_.getBorderFooter(widths_);
+      footer_ += '\n';
+      border_ = table_.border();
+      started_ = true;
+    }
+
+    // the separator of the previous row, now that it isn't the last one
+    else if (hasBottom_)
+    {
+      buffer_ += middle_;
+      buffer_ += '\n';
+    }
+
+    const Border::Part& vertical = row.config().vertical();
+    row.write(buffer_, widths_, vertical.glyph() == '\0' ? border_.vertical() : vertical);
+    buffer_ += '\n';
+
+    hasBottom_ = row.config().hasBottom();
+    sink_(buffer_.data(), buffer_.size());
+  }
+
+  // the widths that fit the content of the sampled rows, the columns with
+  // an explicit width keep the largest one like `Table::genFits()`, see
+  // `detail::fitWidths()`
+  std::vector<size_t> sampleWidths(const std::vector<Row>& rows) const
+  {
+    const size_t columns = rows.front().columns().size();
+    const size_t width = config().width();
+    checkWidth(columns);
+
+    std::vector<size_t> widths(columns, 0);
+    std::vector<size_t> minimum(columns, MIN_COLUMN_WIDTH);
+    std::vector<size_t> maximum(columns, MIN_COLUMN_WIDTH);
+
+    for (const auto& row : rows)
+    {
+      const auto& cols = row.columns();
+      for (size_t i = 0; i < cols.size() && i < columns; ++i)
+      {
+        widths[i] = (std::max)(widths[i], cols[i].config().width());
+
+        minimum[i] = (std::max)(minimum[i], cols[i].minWidth());
+        maximum[i] = (std::max)(maximum[i], cols[i].maxWidth());
+      }
+    }
+
+    return detail::fitWidths(std::move(widths), minimum, maximum,
+                             width - (columns + 1));
+  }
+
+  void checkStarted() const
+  {
+    if (started_)
+      throw std::logic_error("writer error: the first row is already written");
+  }
+
+  // throws if the columns widths are narrower than the minimum or don't
+  // fit in the table's width, the same way `checkWidth()` does
+  void checkWidths() const
+  {
+    const size_t width = config().width();
+
+    size_t rowWidth = widths_.size() + 1;
+    for (const size_t w : widths_)
+    {
+      if (w < MIN_COLUMN_WIDTH)
+      {
+        throw std::runtime_error(
+          "layout error: the columns must have a minimum width of " +
+          std::to_string(MIN_COLUMN_WIDTH) + ", but found " + std::to_string(w));
+      }
+
+      rowWidth += w;
+    }
+
+    if (rowWidth > width)
+    {
+      throw std::runtime_error(
+        "layout error: the rows must have a width of at most " +
+        std::to_string(width) + ", but found " + std::to_string(rowWidth));
+    }
+  }
+
+  // throws if `columns` columns can't fit in the table's width
+  void checkWidth(const size_t columns) const
+  {
+    const size_t width = config().width();
+
+    size_t minWidth = (columns * (MIN_COLUMN_WIDTH + 1)) + 1;
+    if (minWidth > width)
+    {
+      throw std::runtime_error(
+        "layout error: the rows must have a minimum width of " +
+        std::to_string(minWidth) + ", but found " + std::to_string(width));
+    }
+  }
+};
+// clang-format on
+} // namespace tabular
@@ -0,0 +1,161 @@
+#!/usr/bin/env python3
+#
+#      __        ___.         .__
+#    _/  |______ \_ |__  __ __|  | _____ _______
+#    \   __\__  \ | __ \|  |  \  | \__  \\_  __ \
+#     |  |  / __ \| \_\ \  |  /  |__/ __ \|  | \/
+#     |__| (____  /___  /____/|____(____  /__|
+#               \/    \/                \/
+#
+#    *  Author: Anas Hamdane
+#    *  Github: https://github.com/Anas-Hamdane
+#
+#
+# Generates single_include/tabular/tabular.h from the headers in
+# include/tabular: every header once, after the headers it includes, with
+# the standard includes gathered at the top.
+#
+# Run it again whenever a header changes:
+#   python3 scripts/amalgamate.py
+#
+# or check that the single header is up to date, as the tests do:
+#   python3 scripts/amalgamate.py --check
+
+import os
+import re
+import sys
+
+ROOT = os.path.join(os.path.dirname(os.path.abspath(__file__)), os.pardir)
+SOURCE = os.path.join(ROOT, "include", "tabular")
+OUTPUT = os.path.join(ROOT, "single_include", "tabular", "tabular.h")
+
+BANNER = r"""/*
+      __        ___.         .__
+    _/  |______ \_ |__  __ __|  | _____ _______
+    \   __\__  \ | __ \|  |  \  | \__  \\_  __ \
+     |  |  / __ \| \_\ \  |  /  |__/ __ \|  | \/
+     |__| (____  /___  /____/|____(____  /__|
+               \/    \/                \/
+
+    *  Author: Anas Hamdane
+    *  Github: https://github.com/Anas-Hamdane
+*/
+"""
+
+LICENSE = """/*
+  ------------------------------------------------------------------------------
+  MIT License
+  ------------------------------------------------------------------------------
+  Copyright (c) 2025 Anas
+  ------------------------------------------------------------------------------
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+  ------------------------------------------------------------------------------
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+  ------------------------------------------------------------------------------
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+  ------------------------------------------------------------------------------
+*/
+"""
+
+LOCAL = re.compile(r'^\s*#\s*include\s+"([^"]+)"')
+SYSTEM = re.compile(r"^\s*#\s*include\s+<[^>]+>")
+PRAGMA = re.compile(r"^\s*#\s*pragma\s+once")
+OPEN = re.compile(r"^\s*#\s*if")
+CLOSE = re.compile(r"^\s*#\s*endif")
+
+
+def headers():
+    return sorted(name for name in os.listdir(SOURCE) if name.endswith(".h"))
+
+
+def read(name):
+    with open(os.path.join(SOURCE, name), encoding="utf-8") as f:
+        return f.read().splitlines()
+
+
+# the headers in an order where each one follows the headers it includes
+def order():
+    names = set(headers())
+    done = []
+
+    def visit(name, path):
+        if name in done: return
+        if name in path:
+            sys.exit("amalgamate: %s includes itself" % " -> ".join(path + [name]))
+
+        for line in read(name):
+            match = LOCAL.match(line)
+            if match and match.group(1) in names:
+                visit(match.group(1), path + [name])
+
+        done.append(name)
+
+    for name in headers():
+        visit(name, [])
+
+    return done
+
+
+def generate():
+    names = set(headers())
+    includes = []
+    bodies = []
+
+    for name in order():
+        body = []
+        depth = 0
+
+        for line in read(name):
+            match = LOCAL.match(line)
+            if PRAGMA.match(line) or (match and match.group(1) in names):
+                continue
+
+            # the conditional ones stay with their condition
+            if depth == 0 and SYSTEM.match(line):
+                include = line.strip()
+                if include not in includes: includes.append(include)
+                continue
+
+            if OPEN.match(line): depth += 1
+            elif CLOSE.match(line): depth -= 1
+
+            body.append(line)
+
+        bodies.append("\n".join(body).strip("\n"))
+
+    out = BANNER + "\n#pragma once\n\n"
+    out += "\n".join(includes) + "\n\n"
+    out += "\n\n".join(bodies) + "\n\n"
+    out += LICENSE
+
+    return re.sub(r"\n{3,}", "\n\n", out)
+
+
+def main():
+    out = generate()
+
+    if "--check" in sys.argv[1:]:
+        with open(OUTPUT, encoding="utf-8") as f:
+            if f.read() != out:
+                sys.exit("amalgamate: %s is out of date, run scripts/amalgamate.py"
+                         % os.path.relpath(OUTPUT, ROOT))
+        return
+
+    with open(OUTPUT, "w", encoding="utf-8") as f:
+        f.write(out)
+
+
+if __name__ == "__main__":
+    main()
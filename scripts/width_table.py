@@ -0,0 +1,106 @@
+#!/usr/bin/env python3
+#
+#      __        ___.         .__
+#    _/  |______ \_ |__  __ __|  | _____ _______
+#    \   __\__  \ | __ \|  |  \  | \__  \\_  __ \
+#     |  |  / __ \| \_\ \  |  /  |__/ __ \|  | \/
+#     |__| (____  /___  /____/|____(____  /__|
+#               \/    \/                \/
+#
+#    *  Author: Anas Hamdane
+#    *  Github: https://github.com/Anas-Hamdane
+#
+#
+# Generates include/tabular/width_table.h, the two-stage lookup table used
+# by string_utils::wcwidth, from the `combining` and `wide` ranges in
+# include/tabular/string_utils.h.
+#
+# Run it again whenever those ranges change:
+#   python3 scripts/width_table.py
+
+import os
+import re
+
+ROOT = os.path.join(os.path.dirname(os.path.abspath(__file__)), os.pardir)
+SOURCE = os.path.join(ROOT, "include", "tabular", "string_utils.h")
+OUTPUT = os.path.join(ROOT, "include", "tabular", "width_table.h")
+
+BLOCK_BITS = 8
+BLOCK = 1 << BLOCK_BITS
+
+
+def ranges(source, name):
+    body = re.search(r"%s\[\] = \{(.*?)\};" % name, source, re.S).group(1)
+    pairs = re.findall(r"\{(0x[0-9A-Fa-f]+), (0x[0-9A-Fa-f]+)\}", body)
+    return [(int(first, 16), int(last, 16)) for first, last in pairs]
+
+
+def widths(source):
+    combining = ranges(source, "combining")
+    wide = ranges(source, "wide")
+
+    end = max(last for _, last in combining + wide) + 1
+    end = (end + BLOCK - 1) // BLOCK * BLOCK
+
+    table = bytearray([1]) * end
+    for first, last in wide:
+        table[first:last + 1] = bytes([2]) * (last - first + 1)
+
+    # combining characters win over wide ones, same as the range lookup
+    for first, last in combining:
+        table[first:last + 1] = bytes([0]) * (last - first + 1)
+
+    return table
+
+
+def emit(name, ctype, values, per_line, fmt):
+    lines = []
+    for i in range(0, len(values), per_line):
+        chunk = values[i:i + per_line]
+        lines.append("    " + ", ".join(fmt % v for v in chunk) + ",")
+
+    return "static constexpr %s %s[%d] = {\n%s\n};\n" % (
+        ctype, name, len(values), "\n".join(lines))
+
+
+def main():
+    with open(SOURCE, encoding="utf-8") as f:
+        table = widths(f.read())
+
+    blocks = {}
+    stage1 = []
+    for i in range(0, len(table), BLOCK):
+        block = bytes(table[i:i + BLOCK])
+        stage1.append(blocks.setdefault(block, len(blocks)))
+
+    assert len(blocks) <= 256
+
+    # 4 widths (2 bits each) per byte
+    stage2 = []
+    for block in sorted(blocks, key=blocks.get):
+        for i in range(0, BLOCK, 4):
+            packed = 0
+            for j in range(4):
+                packed |= block[i + j] << (2 * j)
+            stage2.append(packed)
+
+    with open(OUTPUT, "w", encoding="utf-8") as f:
+        f.write("#pragma once\n\n")
+        f.write("// generated by scripts/width_table.py, DO NOT EDIT\n\n")
+        f.write("#include <cstdint>\n\n")
+        f.write("namespace tabular {\n")
+        f.write("namespace detail {\n")
+        f.write("// display widths of the code points in [0, widthTableEnd), any code point\n")
+        f.write("// after that is 1 column wide\n")
+        f.write("constexpr uint32_t widthTableEnd = 0x%X;\n" % len(table))
+        f.write("constexpr uint32_t widthBlockBits = %d;\n\n" % BLOCK_BITS)
+        f.write("// the block of each %d code points\n" % BLOCK)
+        f.write(emit("widthStage1", "uint8_t", stage1, 24, "%d"))
+        f.write("\n// the widths inside each block, 2 bits per code point\n")
+        f.write(emit("widthStage2", "uint8_t", stage2, 12, "0x%02X"))
+        f.write("} // namespace detail\n")
+        f.write("} // namespace tabular\n")
+
+
+if __name__ == "__main__":
+    main()
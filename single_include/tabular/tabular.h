@@ -13,9 +13,997 @@
 #pragma once
 
 #include <cstdint>
+#include <atomic>
+#include <cstddef>
+#include <utility>
+#include <algorithm>
+#include <cstring>
 #include <string>
+#include <ostream>
 #include <vector>
 #include <stdexcept>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <system_error>
+#include <thread>
+#include <cmath>
+#include <cstdlib>
+#include <limits>
+#include <numeric>
+#include <map>
+#include <memory>
+#include <cstdio>
+
+namespace tabular {
+enum class Color : uint8_t {
+  Black = 30,
+  Red,
+  Green,
+  Yellow,
+  Blue,
+  Magenta,
+  Cyan,
+  White,
+
+  BrightBlack = 90,
+  BrightRed,
+  BrightGreen,
+  BrightYellow,
+  BrightBlue,
+  BrightMagenta,
+  BrightCyan,
+  BrightWhite,
+};
+struct Rgb {
+  uint8_t r = 0;
+  uint8_t g = 0;
+  uint8_t b = 0;
+
+  constexpr Rgb() = default;
+  constexpr Rgb(uint8_t r, uint8_t g, uint8_t b) : r(r), g(g), b(b) {}
+  constexpr Rgb(uint32_t hex)
+      : r((hex >> 16) & 0xFF), g((hex >> 8) & 0xFF), b(hex & 0xFF)
+  {
+  }
+  constexpr uint32_t toHex() const
+  {
+    return (static_cast<uint32_t>(r) << 16) | (static_cast<uint32_t>(g) << 8) |
+           (static_cast<uint32_t>(b));
+  }
+};
+
+namespace detail {
+  class ColorType {
+    public:
+    ColorType(uint32_t value)
+      : value_(value) {}
+
+    bool isSet() { return value_ != 0; }
+    bool isColor() { return isSet() && (value_ & (3u << 24)) == 0; }
+    bool isRgb() { return isSet() && (value_ & (1u << 24)) != 0; }
+    bool isPalette() { return isSet() && (value_ & (1u << 25)) != 0; }
+
+    Color color() { return static_cast<Color>(value_ & 0xFFFFFF); }
+    Rgb rgb() { return {value_ & 0xFFFFFF}; }
+    uint8_t palette() { return static_cast<uint8_t>(value_ & 0xFF); }
+
+    private:
+    uint32_t value_;
+  };
+}
+} // namespace tabular
+
+namespace tabular {
+enum class Attr : uint16_t {
+  Bold = 1,
+  Dim = 1 << 1,
+  Italic = 1 << 2,
+
+  Underline = 1 << 3,
+  Dunderline = 1 << 4, // not popular
+
+  Blink = 1 << 5, // rarely supported
+  Flink = 1 << 6, // rarely supported
+  Reverse = 1 << 7,
+  Concealed = 1 << 8,
+  Crossed = 1 << 9,
+};
+
+enum class Align { Left, Right, Center };
+struct Padd {
+  uint8_t top = 0;
+  uint8_t bottom = 0;
+  uint8_t left = 1;
+  uint8_t right = 1;
+
+  constexpr Padd() = default;
+  constexpr Padd(uint8_t vertical, uint8_t horizontal)
+      : top(vertical), bottom(vertical), left(horizontal), right(horizontal)
+  {
+  }
+  constexpr Padd(uint8_t top, uint8_t bottom, uint8_t left, uint8_t right)
+      : top(top), bottom(bottom), left(left), right(right)
+  {
+  }
+
+  constexpr bool operator==(const Padd& other) const
+  {
+    return top == other.top && bottom == other.bottom && left == other.left &&
+           right == other.right;
+  }
+  constexpr bool operator!=(const Padd& other) const { return !(*this == other); }
+};
+
+constexpr auto RESET_ESC = "\x1b[0m";
+constexpr uint8_t WORD_LENGTH_AVERAGE = 5;
+constexpr uint64_t DEFAULT_WIDTH = 50;
+
+// the maximum display width of a Unicode character
+constexpr uint8_t MIN_COLUMN_WIDTH = 2;
+
+// the rows rendered by a single task when the rows are rendered in parallel
+constexpr size_t ROWS_PER_TASK = 256;
+
+// the separators between rows layouts a table remembers
+constexpr size_t MAX_MEMOIZED_SEPARATORS = 64;
+
+namespace detail {
+// a new stamp for an object that just changed, stamps are unique and always
+// increasing, so comparing the stamp of an object with the one its cache was
+// generated with tells whether it changed since, even if it was replaced by
+// another object
+inline uint64_t nextGeneration()
+{
+  static std::atomic<uint64_t> generation{0};
+  return generation.fetch_add(1, std::memory_order_relaxed) + 1;
+}
+
+// the stamp of an object's last change. copies keep it since they hold the
+// same state, but assigning over an object changes it, so handing out
+// references never has to count as a change
+class Generation {
+public:
+  Generation() = default;
+  Generation(const Generation&) = default;
+
+  Generation& operator=(const Generation&) noexcept
+  {
+    bump();
+    return *this;
+  }
+
+  void bump() noexcept { value_ = nextGeneration(); }
+  operator uint64_t() const noexcept { return value_; }
+
+private:
+  uint64_t value_ = 0;
+};
+
+// sets a field of an object, setting the value it already has isn't a change
+template<typename T, typename U>
+void assign(T& field, U&& value, Generation& generation)
+{
+  if (field == value) return;
+
+  field = std::forward<U>(value);
+  generation.bump();
+}
+} // namespace detail
+} // namespace tabular
+
+// generated by scripts/width_table.py, DO NOT EDIT
+
+namespace tabular {
+namespace detail {
+// display widths of the code points in [0, widthTableEnd), any code point
+// after that is 1 column wide
+constexpr uint32_t widthTableEnd = 0xE0200;
+constexpr uint32_t widthBlockBits = 8;
+
+// the block of each 256 code points
+static constexpr uint8_t widthStage1[3586] = {
+    0, 1, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16, 1, 17, 1, 1, 1, 18,
+    19, 20, 21, 22, 23, 24, 1, 1, 25, 1, 1, 26, 1, 27, 28, 29, 1, 1, 1, 30, 31, 32, 33, 34,
+    35, 36, 37, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38,
+    38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38,
+    38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38,
+    38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38,
+    38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 39, 1, 40, 1,
+    41, 42, 43, 44, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38,
+    38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 45,
+    46, 46, 46, 46, 46, 46, 46, 46, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 38, 47, 48, 1, 1, 49, 50, 1, 51, 52, 53, 1, 1, 1, 1,
+    1, 1, 54, 1, 1, 55, 56, 57, 58, 59, 60, 61, 62, 63, 64, 65, 66, 67, 68, 1, 69, 70, 71, 72,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 73, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 74, 1, 1, 1, 1, 1, 1,
+    1, 1, 75, 76, 1, 1, 1, 77, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38,
+    38, 38, 38, 38, 38, 38, 38, 78, 38, 38, 38, 38, 79, 80, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 81,
+    38, 82, 83, 1, 1, 1, 1, 1, 1, 1, 1, 1, 84, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 85, 1, 86, 87, 88, 1, 1, 1, 1, 1, 1, 89, 1, 1, 1, 1, 1,
+    90, 76, 91, 1, 92, 93, 1, 1, 94, 95, 1, 1, 1, 1, 1, 1, 96, 97, 98, 99, 100, 101, 102, 103,
+    1, 104, 105, 1, 1, 1, 1, 1, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38,
+    38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38,
+    38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38,
+    38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38,
+    38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38,
+    38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38,
+    38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38,
+    38, 38, 38, 38, 38, 38, 106, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 107,
+    108, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 109, 38,
+    38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38,
+    38, 38, 38, 110, 38, 38, 111, 1, 1, 1, 1, 1, 1, 1, 1, 1, 38, 38, 112, 1, 1, 1, 1, 1,
+    38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 113, 38, 38, 38, 38,
+    38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 114, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 115, 116,
+};
+
+// the widths inside each block, 2 bits per code point
+static constexpr uint8_t widthStage2[7488] = {
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x55, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x15, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x15, 0x00, 0x50, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x10, 0x41, 0x10, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x00, 0x50, 0x55, 0x55,
+    0x00, 0x00, 0x40, 0x54, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x15, 0x00, 0x00, 0x00, 0x00, 0x00, 0x55, 0x55, 0x55, 0x55,
+    0x54, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+    0x55, 0x05, 0x00, 0x10, 0x00, 0x14, 0x04, 0x50, 0x55, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x15, 0x51, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x40, 0x55, 0x55, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0x55, 0x05, 0x00, 0x00, 0x54, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x15, 0x00,
+    0x00, 0x55, 0x55, 0x51, 0x55, 0x55, 0x55, 0x55, 0x55, 0x05, 0x10, 0x00,
+    0x00, 0x01, 0x01, 0x50, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x01, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0x50, 0x15, 0x00, 0x00, 0x55, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x05, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x05, 0x04,
+    0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x55, 0x55, 0x05, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0x01, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x04, 0x00, 0x14, 0x14, 0x50,
+    0x55, 0x15, 0x55, 0x55, 0x05, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x45,
+    0x01, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x04, 0x40, 0x15, 0x14, 0x50, 0x51, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0x50, 0x51, 0x55, 0x55, 0x01, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x04,
+    0x00, 0x10, 0x10, 0x50, 0x55, 0x55, 0x55, 0x55, 0x05, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x05, 0x00, 0x01, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x04, 0x00, 0x14, 0x14, 0x50,
+    0x55, 0x01, 0x55, 0x55, 0x05, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+    0x45, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x05, 0x40, 0x05, 0x04, 0x50, 0x55, 0x15, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x00, 0x54, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x04,
+    0x00, 0x04, 0x04, 0x50, 0x55, 0x41, 0x55, 0x55, 0x05, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0x01, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x04, 0x00, 0x04, 0x04, 0x50,
+    0x55, 0x41, 0x55, 0x55, 0x05, 0x55, 0x55, 0x55, 0x15, 0x55, 0x55, 0x55,
+    0x00, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x15, 0x04, 0x00, 0x04, 0x04, 0x50, 0x55, 0x15, 0x55, 0x55,
+    0x05, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x01, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x45, 0x15, 0x00, 0x44, 0x00, 0x00, 0x55, 0x55, 0x55, 0x55,
+    0x05, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0x51, 0x00, 0x40, 0x55, 0x55, 0x15, 0x00, 0x40,
+    0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+    0x51, 0x00, 0x00, 0x54, 0x55, 0x55, 0x00, 0x40, 0x55, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x50, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x11, 0x51, 0x05,
+    0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+    0x01, 0x00, 0x00, 0x00, 0x00, 0x04, 0x55, 0x01, 0x00, 0x00, 0x01, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x54, 0x55, 0x45, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x15, 0x00,
+    0x00, 0x00, 0x00, 0x40, 0x55, 0x55, 0x55, 0x55, 0x55, 0x05, 0x50, 0x05,
+    0x04, 0x14, 0x00, 0x50, 0x01, 0x54, 0x55, 0x55, 0x05, 0x00, 0x00, 0x10,
+    0x55, 0x55, 0x05, 0x50, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA,
+    0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA,
+    0xAA, 0xAA, 0xAA, 0xAA, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x01, 0x55, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0x05, 0x50, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+    0x05, 0x54, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x05, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0x05, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x55, 0x55, 0x51, 0x55, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x15, 0x00, 0x55, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+    0x55, 0x41, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x51, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0x00, 0x00, 0x00, 0x55, 0x00, 0x00, 0x00, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0x55, 0x15, 0x00, 0x55, 0x55, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x01, 0x00, 0x40,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x14, 0x55, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x40, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0x00, 0x54, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0x55, 0x00, 0x00, 0x00, 0x00, 0x54, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x15, 0x00, 0x00, 0x55, 0x55, 0x55,
+    0x40, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x01, 0x00, 0x00, 0x50,
+    0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+    0x55, 0x05, 0x00, 0x00, 0x00, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0x55, 0x00, 0x00, 0x00, 0x00, 0x00, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+    0x40, 0x00, 0x00, 0x00, 0x00, 0x00, 0x54, 0x51, 0x55, 0x14, 0x50, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x55, 0x55, 0x15, 0x00, 0x55, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x00, 0x40, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0x00, 0x04, 0x00, 0x00, 0x55, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x54, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0xA5, 0x55, 0x55, 0x55, 0x69, 0x55, 0x55, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0xA9, 0x56, 0x96, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x69, 0x55, 0x55, 0x55, 0x55, 0x55, 0x5A, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0xAA, 0xAA, 0x55, 0x55, 0x55, 0x55, 0xAA, 0xAA,
+    0xAA, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x95,
+    0x55, 0x55, 0xA5, 0xAA, 0x95, 0x55, 0x55, 0x55, 0x59, 0x55, 0xA5, 0x55,
+    0x55, 0x55, 0x55, 0x69, 0x55, 0x5A, 0x55, 0x65, 0x55, 0x56, 0x55, 0x55,
+    0x55, 0x55, 0x65, 0x55, 0xA5, 0x59, 0x65, 0x59, 0x55, 0x59, 0xA5, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x56, 0x55, 0x55, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x66, 0x95, 0x9A, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0xA9, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0x56, 0x55, 0x55, 0x95, 0x55, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x95, 0x56, 0x55, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x56, 0x59, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x15, 0x50, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x15, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0xAA, 0xAA, 0xAA, 0xAA,
+    0xAA, 0xAA, 0x9A, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA,
+    0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA,
+    0xAA, 0x55, 0x55, 0x55, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA,
+    0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA,
+    0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA,
+    0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA,
+    0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0x5A, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA,
+    0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0x0A, 0xA0, 0xAA, 0xAA, 0xAA, 0x6A,
+    0xA9, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA,
+    0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0x6A, 0x81, 0xAA,
+    0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA,
+    0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA,
+    0x55, 0xA9, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA,
+    0xA9, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA,
+    0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0x6A,
+    0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA,
+    0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0x5A, 0x55, 0x95,
+    0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0x6A,
+    0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0x55, 0x55,
+    0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA,
+    0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA,
+    0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA,
+    0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA,
+    0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA,
+    0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA,
+    0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA,
+    0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA,
+    0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA,
+    0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA,
+    0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA,
+    0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0x56,
+    0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA,
+    0xAA, 0x6A, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x15, 0x40, 0x00, 0x00, 0x50,
+    0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x05, 0x55, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0x50, 0x55, 0x55, 0x55, 0x45, 0x45, 0x15, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0x15, 0x00, 0x55, 0x54, 0x55, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0x50, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0x55, 0x00, 0x00, 0x00, 0x00, 0x50, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0x00, 0x00, 0x00, 0x00, 0x50, 0x55, 0x55, 0x15,
+    0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x05, 0x00, 0x50,
+    0x55, 0x55, 0x55, 0x55, 0x55, 0x15, 0x00, 0x00, 0x00, 0x55, 0x55, 0x55,
+    0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0x56, 0x00, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x15, 0x00, 0x00, 0x00,
+    0x54, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x51, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x01, 0x00, 0x00, 0x40, 0x55, 0x55, 0x15, 0x55, 0x55, 0x50,
+    0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x15, 0x50,
+    0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+    0x04, 0x14, 0x54, 0x05, 0x51, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x15, 0x00, 0x55, 0x41, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0x15, 0x00, 0x40, 0x50, 0x55, 0x55, 0x55, 0x55,
+    0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA,
+    0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA,
+    0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA,
+    0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xAA, 0xAA, 0xAA, 0xAA,
+    0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA,
+    0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0x5A,
+    0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA,
+    0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA,
+    0xAA, 0xAA, 0x5A, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x45, 0x55, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0x00, 0x00, 0x00, 0x00, 0xAA, 0xAA, 0x5A, 0x55,
+    0x00, 0x00, 0x00, 0x00, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA,
+    0x6A, 0xAA, 0xAA, 0xAA, 0xAA, 0x6A, 0xAA, 0x55, 0x55, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x15, 0xA9, 0xAA, 0xAA, 0xAA,
+    0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA,
+    0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0x56, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0xAA, 0x6A, 0x55, 0x55, 0x55, 0x55, 0x01, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x51, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+    0x54, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+    0x55, 0x05, 0x40, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+    0x01, 0x41, 0x55, 0x00, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x40, 0x15, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x41, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+    0x55, 0x00, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x01, 0x50, 0x55, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x15, 0x54, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x00,
+    0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0x55, 0x05, 0x00, 0x00, 0x54, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x05, 0x50, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0x40, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x00, 0x00, 0x00, 0x40, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x14, 0x54, 0x55, 0x15,
+    0x40, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+    0x00, 0x00, 0x40, 0x51, 0x45, 0x55, 0x55, 0x51, 0x55, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x40, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0x55, 0x15, 0x00, 0x00, 0x00, 0x54, 0x55, 0x55,
+    0x55, 0x41, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+    0x15, 0x55, 0x55, 0x55, 0x40, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0x15, 0x00, 0x00, 0x00, 0x54, 0x55, 0x01, 0x04,
+    0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x00,
+    0x00, 0x00, 0x55, 0x45, 0x51, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x15, 0x00, 0x00, 0x40, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0x00, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x15, 0x04, 0x00, 0x14, 0x14, 0x50,
+    0x55, 0x15, 0x55, 0x55, 0x05, 0x05, 0x00, 0x54, 0x00, 0x54, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x00, 0x00, 0x44, 0x11, 0x40, 0x00, 0x44, 0x55, 0x55, 0x55,
+    0x41, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x01, 0x00, 0x00,
+    0x00, 0x40, 0x55, 0x55, 0x55, 0x55, 0x55, 0x45, 0x55, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0x00, 0x00, 0x00, 0x00, 0x00, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x15, 0x00, 0x50, 0x00, 0x00,
+    0x54, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x50, 0x55, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0x00, 0x00, 0x00, 0x00, 0x54, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x15, 0x00,
+    0x00, 0x00, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x01, 0x00, 0x00, 0x00, 0x55, 0x55, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x00,
+    0x00, 0x00, 0x40, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0x00, 0x10, 0x14, 0x40, 0x04, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x01, 0x00, 0x05, 0x00,
+    0x54, 0x54, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x01, 0x00, 0x40, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x15, 0x00, 0x10, 0x40,
+    0x55, 0x15, 0x55, 0x55, 0x01, 0x00, 0x00, 0x55, 0x55, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x05, 0x00, 0x00, 0x00, 0x50, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x15,
+    0x00, 0x40, 0x00, 0x00, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+    0x05, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x40, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0x01, 0x40, 0x45, 0x10, 0x00, 0x10, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x05, 0x40, 0x10, 0x00, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x15, 0x40, 0x55, 0x55,
+    0x10, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+    0x55, 0x00, 0x40, 0x05, 0x40, 0x55, 0x55, 0x55, 0x55, 0x55, 0x45, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0x00, 0x00, 0x00, 0x00, 0x54, 0x15, 0x00, 0x00,
+    0x00, 0x50, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x05, 0x00, 0x00, 0x00, 0x00, 0x55, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+    0x00, 0x54, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0x00, 0x40, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x15, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x55, 0x15, 0x40, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0xAA, 0x54, 0x55, 0x55, 0x5A, 0x55, 0x55, 0x55,
+    0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA,
+    0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA,
+    0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA,
+    0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA,
+    0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA,
+    0xAA, 0xAA, 0x55, 0x55, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA,
+    0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA,
+    0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA,
+    0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA,
+    0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0x5A, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x95, 0xAA, 0xAA, 0x56, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+    0xAA, 0xA9, 0xAA, 0x69, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA,
+    0x6A, 0x55, 0x55, 0x55, 0x65, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+    0x6A, 0x59, 0x55, 0x55, 0x55, 0xAA, 0x55, 0x55, 0xAA, 0xAA, 0xAA, 0xAA,
+    0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA,
+    0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA,
+    0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA,
+    0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA,
+    0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA,
+    0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA,
+    0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA,
+    0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x41, 0x00, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x50, 0x00, 0x00, 0x00, 0x00, 0x00, 0x40, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x01, 0x50, 0x01,
+    0x00, 0x00, 0x00, 0x00, 0x40, 0x01, 0x00, 0x55, 0x55, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x05, 0x50, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0x05, 0x54, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA,
+    0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA,
+    0xAA, 0x6A, 0x55, 0x55, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0x6A, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x40, 0x15, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x54,
+    0x55, 0x51, 0x55, 0x55, 0x55, 0x54, 0x55, 0x55, 0x55, 0x55, 0x15, 0x00,
+    0x01, 0x00, 0x00, 0x00, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+    0x00, 0x40, 0x00, 0x00, 0x00, 0x00, 0x14, 0x00, 0x10, 0x04, 0x40, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x15,
+    0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x45,
+    0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x00, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x00, 0x55, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x05,
+    0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x00, 0x40, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+    0x55, 0x00, 0x40, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+    0x55, 0x56, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x95, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x65, 0xA9, 0xAA, 0x6A, 0x55, 0x55, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x6A, 0x55, 0x55, 0x55,
+    0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0x55,
+    0xAA, 0xAA, 0x56, 0x55, 0x5A, 0x55, 0x55, 0x55, 0xAA, 0x5A, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+    0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0x56, 0x55, 0x55, 0xA9,
+    0xAA, 0x9A, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA,
+    0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xA6, 0xAA, 0xAA, 0xAA, 0xAA,
+    0xAA, 0x55, 0x55, 0x55, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA,
+    0xAA, 0xAA, 0x6A, 0x95, 0xAA, 0x55, 0x55, 0x55, 0xAA, 0xAA, 0xAA, 0xAA,
+    0x56, 0x56, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA,
+    0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0x6A, 0xA6, 0xAA, 0xAA, 0xAA,
+    0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA,
+    0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA,
+    0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA,
+    0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0x96, 0xAA, 0xAA, 0xAA, 0xAA,
+    0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0x5A,
+    0x55, 0x55, 0x95, 0x6A, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0x55, 0x55,
+    0x55, 0x55, 0x65, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x69, 0x55, 0x55,
+    0x55, 0x56, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x95, 0xAA,
+    0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA,
+    0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0x55, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0xAA, 0xAA, 0xAA, 0xAA,
+    0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA,
+    0xAA, 0x5A, 0x55, 0x56, 0x6A, 0xA9, 0x55, 0xAA, 0x55, 0x55, 0x95, 0x56,
+    0x55, 0xAA, 0xAA, 0x56, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+    0xAA, 0xAA, 0xAA, 0x55, 0x56, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0xAA,
+    0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0x6A, 0xAA,
+    0xAA, 0x9A, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA,
+    0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA,
+    0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA,
+    0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA,
+    0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0xAA, 0xAA, 0xAA, 0x56, 0xAA, 0xAA, 0x5A, 0x95,
+    0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA,
+    0xAA, 0x6A, 0x55, 0xA5, 0xAA, 0xAA, 0xAA, 0x96, 0xAA, 0xAA, 0x5A, 0x55,
+    0xAA, 0xAA, 0x56, 0x55, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA,
+    0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA,
+    0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA,
+    0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA,
+    0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA,
+    0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0xAA, 0xAA, 0xAA, 0xAA,
+    0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0x5A, 0x55,
+    0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA,
+    0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA,
+    0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA,
+    0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA,
+    0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0x5A, 0xAA, 0xAA, 0xAA, 0xAA,
+    0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA,
+    0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA,
+    0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA,
+    0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA,
+    0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA,
+    0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA,
+    0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA,
+    0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0x5A, 0x55, 0x55, 0x55,
+    0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA,
+    0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA,
+    0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA,
+    0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA,
+    0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA,
+    0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA,
+    0xAA, 0xAA, 0xAA, 0xAA, 0x56, 0x55, 0x55, 0x55, 0xAA, 0xAA, 0xAA, 0xAA,
+    0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA,
+    0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0x5A,
+    0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0x5A,
+    0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0xAA, 0xAA, 0xAA, 0xAA,
+    0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA,
+    0xAA, 0xAA, 0x6A, 0x55, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA,
+    0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA,
+    0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA,
+    0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA,
+    0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA,
+    0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA,
+    0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA,
+    0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0x55, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0x51, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+    0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x55, 0x55, 0x55, 0x55,
+};
+} // namespace detail
+} // namespace tabular
+
+#if __cplusplus >= 201703L || (defined(_MSVC_LANG) && _MSVC_LANG >= 201703L)
+#include <string_view>
+#define TABULAR_HAS_STRING_VIEW
+#endif
+
+// vectorized ascii scanning, define TABULAR_NO_SIMD to force the scalar path
+#if !defined(TABULAR_NO_SIMD)
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define TABULAR_DETAIL_AVX2
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define TABULAR_DETAIL_SSE2
+#endif
+#endif
+
+#if defined(_MSC_VER) && (defined(TABULAR_DETAIL_AVX2) || defined(TABULAR_DETAIL_SSE2))
+#include <intrin.h>
+#endif
 
 namespace tabular {
 namespace detail {
@@ -24,6 +1012,8 @@ struct Range {
   uint32_t last;
 };
 
+// the source data of width_table.h, regenerate it after editing these ranges
+// Zero width characters (control, combining, format)
 constexpr static Range combining[] = {
     {0x0000, 0x001F}, {0x007F, 0x009F}, {0x0300, 0x036F}, {0x0483, 0x0489},
     {0x0591, 0x05BD}, {0x05BF, 0x05BF}, {0x05C1, 0x05C2}, {0x05C4, 0x05C5},
@@ -177,27 +1167,68 @@ inline bool bisearch(uint32_t ucs, const Range* interval, int max)
   return false;
 }
 
-inline bool bisearch(const std::vector<size_t>& vec, size_t value)
+#if defined(TABULAR_DETAIL_AVX2) || defined(TABULAR_DETAIL_SSE2)
+// index of the lowest set bit, `mask` must not be 0
+inline unsigned ctz(const uint32_t mask)
 {
-  size_t left = 0;
-  size_t right = vec.size();
+#if defined(_MSC_VER)
+  unsigned long index;
+  _BitScanForward(&index, mask);
+  return static_cast<unsigned>(index);
+#else
+  return static_cast<unsigned>(__builtin_ctz(mask));
+#endif
+}
+#endif
+
+// returns the length of the leading run of printable ascii characters
+// (0x20 - 0x7E) in [begin, end), each one of them is exactly 1 column wide
+// so the caller can skip the whole run without decoding it
+inline size_t asciiRun(const char* begin, const char* end)
+{
+  const char* ptr = begin;
+
+#if defined(TABULAR_DETAIL_AVX2)
+  const __m256i low32 = _mm256_set1_epi8(0x1F);
+  const __m256i high32 = _mm256_set1_epi8(0x7F);
+
+  while (end - ptr >= 32)
+  {
+    const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(ptr));
+
+    // bytes >= 0x80 are negative as signed chars, so they fail the first test
+    const __m256i printable = _mm256_and_si256(_mm256_cmpgt_epi8(v, low32),
+                                               _mm256_cmpgt_epi8(high32, v));
+
+    const auto mask = static_cast<uint32_t>(_mm256_movemask_epi8(printable));
+    if (mask != 0xFFFFFFFFu) return static_cast<size_t>(ptr - begin) + ctz(~mask);
+
+    ptr += 32;
+  }
+#endif
 
-  while (left < right)
+#if defined(TABULAR_DETAIL_AVX2) || defined(TABULAR_DETAIL_SSE2)
+  const __m128i low16 = _mm_set1_epi8(0x1F);
+  const __m128i high16 = _mm_set1_epi8(0x7F);
+
+  while (end - ptr >= 16)
   {
-    size_t mid = left + (right - left) / 2;
+    const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(ptr));
+    const __m128i printable =
+        _mm_and_si128(_mm_cmpgt_epi8(v, low16), _mm_cmpgt_epi8(high16, v));
 
-    if (vec[mid] == value) return true;
+    const auto mask = static_cast<uint32_t>(_mm_movemask_epi8(printable));
+    if (mask != 0xFFFFu) return static_cast<size_t>(ptr - begin) + ctz(~mask);
 
-    if (vec[mid] < value) left = mid + 1;
-    else right = mid;
+    ptr += 16;
   }
-  return false;
-}
+#endif
 
-struct Str {
-  std::string str;
-  size_t dw;
-};
+  while (ptr < end && *ptr >= 0x20 && *ptr < 0x7F)
+    ++ptr;
+
+  return static_cast<size_t>(ptr - begin);
+}
 }
 
 namespace string_utils {
@@ -217,9 +1248,9 @@ constexpr bool isAlpha(const char character)
          (character >= 'a' && character <= 'z');
 }
 
-// convert a utf8 encoded sequence to a wide characters
-// returns true if it's a valid utf8 string
-inline bool utf8twc(const char* s, uint32_t& wc, int& consumed)
+// convert a utf8 encoded sequence of at most `len` bytes to a wide character
+// returns true if it's a valid utf8 sequence
+inline bool utf8twc(const char* s, const size_t len, uint32_t& wc, int& consumed)
 {
   const auto* u = reinterpret_cast<const unsigned char*>(s);
   const unsigned char c = u[0];
@@ -236,6 +1267,9 @@ inline bool utf8twc(const char* s, uint32_t& wc, int& consumed)
   consumed = detail::utf8Len[c];
   if (consumed == 0) return false;
 
+  // truncated sequence
+  if (static_cast<size_t>(consumed) > len) return false;
+
   switch (consumed)
   {
   case 2:
@@ -260,54 +1294,67 @@ inline bool utf8twc(const char* s, uint32_t& wc, int& consumed)
   }
 }
 
+// convert a NUL terminated utf8 encoded sequence to a wide characters
+// returns true if it's a valid utf8 string
+inline bool utf8twc(const char* s, uint32_t& wc, int& consumed)
+{
+  // the NUL terminator stops the sequence on its own
+  return utf8twc(s, 4, wc, consumed);
+}
 
 // return the display width of a Unicode character
+// NOTE: it's a two-stage table lookup, see scripts/width_table.py
 inline size_t wcwidth(const uint32_t ucs)
 {
   using namespace detail;
 
-  if (ucs == 0) return 0;
-  if (ucs < 32 || (ucs >= 0x7f && ucs < 0xa0)) return 0;
-
-  if (bisearch(ucs, combining,
-               (sizeof(combining) / sizeof(std::pair<uint32_t, uint32_t>)) - 1))
-    return 0;
+  if (ucs >= widthTableEnd) return 1;
 
-  if (bisearch(ucs, wide,
-               (sizeof(wide) / sizeof(std::pair<uint32_t, uint32_t>)) - 1))
-    return 2;
+  const uint32_t block = widthStage1[ucs >> widthBlockBits];
+  const uint32_t offset = ucs & ((1u << widthBlockBits) - 1);
 
-  return 1;
+  const uint8_t packed = widthStage2[(block << (widthBlockBits - 2)) | (offset >> 2)];
+  return (packed >> ((offset & 3) * 2)) & 3;
 }
 
-// calculates the display width of a given utf8 string
-inline size_t dw(const char* str)
+// calculates the display width of the first `len` bytes of a utf8 string
+inline size_t dw(const char* str, const size_t len)
 {
   using namespace detail;
 
   size_t width = 0;
   const char* ptr = str;
+  const char* end = str + len;
 
-  while (*ptr)
+  while (ptr < end)
   {
+    // printable ascii runs are measured in bulk
+    if (*ptr >= 0x20 && *ptr < 0x7F)
+    {
+      const size_t run = asciiRun(ptr, end);
+      width += run;
+      ptr += run;
+      continue;
+    }
+
     // skip ansi escape sequences
     if (*ptr == '\x1b')
     {
       // skip every ascii character until a non-ascii one
       // or an alphabet is found
       ++ptr;
-      while (*ptr && isAscii(*ptr) && !isAlpha(*ptr))
+      while (ptr < end && isAscii(*ptr) && !isAlpha(*ptr))
         ++ptr;
 
       // skip the first alphabet too
-      if (*ptr && isAlpha(*ptr)) ++ptr;
+      if (ptr < end && isAlpha(*ptr)) ++ptr;
       continue;
     }
 
     // UTF-8 characters
     uint32_t wc;
     int consumed = 1;
-    if (utf8twc(ptr, wc, consumed))
+    if (utf8twc(ptr, static_cast<size_t>(end - ptr), wc, consumed))
     {
       width += string_utils::wcwidth(wc);
       ptr += consumed;
@@ -324,45 +1371,68 @@ inline size_t dw(const char* str)
   return width;
 }
 
+// calculates the display width of a given NUL terminated utf8 string
+inline size_t dw(const char* str)
+{
+  return dw(str, std::char_traits<char>::length(str));
+}
+
 inline size_t dw(const std::string& str)
 {
-  return dw(str.c_str());
+  return dw(str.data(), str.length());
 }
 
-inline std::string readUtf8Char(const std::string& str, const size_t pos)
+#ifdef TABULAR_HAS_STRING_VIEW
+inline size_t dw(const std::string_view str)
+{
+  return dw(str.data(), str.length());
+}
+#endif
+
+// returns the length of the utf8 sequence starting at `str[pos]`,
+// or 0 if it's invalid or truncated
+inline size_t utf8CharLen(const char* str, const size_t len, const size_t pos)
 {
-  if (pos >= str.length()) return "";
+  if (pos >= len) return 0;
 
   const auto first_byte = static_cast<unsigned char>(str[pos]);
 
   // if it's a continuation byte then it's invalid
-  if ((first_byte & 0xC0) == 0x80) return "";
+  if ((first_byte & 0xC0) == 0x80) return 0;
 
   // find the length of the sequence from the start byte
-  size_t len;
+  size_t charLen;
   if ((first_byte & 0x80) == 0)
-    len = 1;
+    charLen = 1;
   else if ((first_byte & 0xE0) == 0xC0)
-    len = 2;
+    charLen = 2;
   else if ((first_byte & 0xF0) == 0xE0)
-    len = 3;
+    charLen = 3;
   else if ((first_byte & 0xF8) == 0xF0)
-    len = 4;
+    charLen = 4;
   else
-    return "";
+    return 0;
 
   // not enough bytes
-  if (pos + len > str.length()) return "";
+  if (pos + charLen > len) return 0;
 
   // validate
-  for (size_t i = 1; i < len; ++i)
+  for (size_t i = 1; i < charLen; ++i)
   {
     if ((static_cast<unsigned char>(str[pos + i]) & 0xC0) != 0x80)
     {
-      return "";
+      return 0;
     }
   }
 
+  return charLen;
+}
+
+inline std::string readUtf8Char(const std::string& str, const size_t pos)
+{
+  const size_t len = utf8CharLen(str.data(), str.length(), pos);
+  if (len == 0) return "";
+
   return str.substr(pos, len);
 }
 
@@ -373,1769 +1443,4334 @@ inline bool endsWith(const std::string& str, const std::string& with)
   if (n < len) return false;
   return str.compare(n - len, len, with) == 0;
 }
-}
-
-enum class Color : uint8_t {
-  Black = 30,
-  Red,
-  Green,
-  Yellow,
-  Blue,
-  Magenta,
-  Cyan,
-  White,
 
-  BrightBlack = 90,
-  BrightRed,
-  BrightGreen,
-  BrightYellow,
-  BrightBlue,
-  BrightMagenta,
-  BrightCyan,
-  BrightWhite,
-};
-struct Rgb {
-  uint8_t r = 0;
-  uint8_t g = 0;
-  uint8_t b = 0;
+// the string without its escape sequences, read the same way `dw` skips them
+inline std::string stripEscapes(const std::string& str)
+{
+  std::string stripped;
+  stripped.reserve(str.size());
 
-  constexpr Rgb() = default;
-  constexpr Rgb(uint8_t r, uint8_t g, uint8_t b) : r(r), g(g), b(b) {}
-  constexpr Rgb(uint32_t hex)
-      : r((hex >> 16) & 0xFF), g((hex >> 8) & 0xFF), b(hex & 0xFF)
-  {
-  }
-  constexpr uint32_t toHex() const
+  const char* ptr = str.data();
+  const char* end = ptr + str.size();
+  while (ptr < end)
   {
-    return (static_cast<uint32_t>(r) << 16) | (static_cast<uint32_t>(g) << 8) |
-           (static_cast<uint32_t>(b));
-  }
-};
-
-namespace detail {
-class ColorType {
-  public:
-  ColorType(uint32_t value)
-    : value_(value) {}
+    const char* escape = std::find(ptr, end, '\x1b');
+    stripped.append(ptr, escape);
+    if (escape == end) break;
 
-  bool isSet() { return value_ != 0; }
-  bool isColor() { return isSet() && (value_ & (1u << 24)) == 0; }
-  bool isRgb() { return isSet() && (value_ & (1u << 24)) != 0; }
+    ptr = escape + 1;
+    while (ptr < end && isAscii(*ptr) && !isAlpha(*ptr))
+      ++ptr;
 
-  Color color() { return static_cast<Color>(value_ & 0xFFFFFF); }
-  Rgb rgb() { return {value_ & 0xFFFFFF}; }
+    if (ptr < end && isAlpha(*ptr)) ++ptr;
+  }
 
-  private:
-  uint32_t value_;
-};
+  return stripped;
 }
 
-enum class Attr : uint16_t {
-  Bold = 1,
-  Dim = 1 << 1,
-  Italic = 1 << 2,
-
-  Underline = 1 << 3,
-  Dunderline = 1 << 4, // not popular
+// appends `count` copies of the `len` bytes at `str`, the copied part is
+// doubled every time so it takes a few copies instead of one per repeat
+inline void repeat(std::string& out, const char* str, const size_t len,
+                   const size_t count)
+{
+  const size_t total = len * count;
+  if (total == 0) return;
 
-  Blink = 1 << 5, // rarely supported
-  Flink = 1 << 6, // rarely supported
-  Reverse = 1 << 7,
-  Concealed = 1 << 8,
-  Crossed = 1 << 9,
-};
+  const size_t start = out.size();
+  out.resize(start + total);
 
-enum class Align { Left, Right, Center };
-struct Padd {
-  uint8_t top = 0;
-  uint8_t bottom = 0;
-  uint8_t left = 1;
-  uint8_t right = 1;
+  char* dst = &out[start];
+  std::memcpy(dst, str, len);
 
-  constexpr Padd() = default;
-  constexpr Padd(uint8_t vertical, uint8_t horizontal)
-      : top(vertical), bottom(vertical), left(horizontal), right(horizontal)
+  for (size_t filled = len; filled < total;)
   {
+    const size_t n = (std::min)(filled, total - filled);
+    std::memcpy(dst + filled, dst, n);
+    filled += n;
   }
-  constexpr Padd(uint8_t top, uint8_t bottom, uint8_t left, uint8_t right)
-      : top(top), bottom(bottom), left(left), right(right)
-  {
-  }
-};
-
-constexpr auto RESET_ESC = "\x1b[0m";
-constexpr uint8_t WORD_LENGTH_AVERAGE = 5;
-constexpr uint64_t DEFAULT_WIDTH = 50;
+}
+}
+}
 
-// the maximum display width of a Unicode character
-constexpr uint8_t MIN_COLUMN_WIDTH = 2;
+// the SIMD paths are an implementation detail
+#undef TABULAR_DETAIL_AVX2
+#undef TABULAR_DETAIL_SSE2
 
-class Column {
-public:
-  class Style {
+namespace tabular {
+// clang-format off
+class Border {
+public:
+  class Part {
   public:
-    explicit Style(bool& dirty_) : dirty_(dirty_)
+    Part(const uint32_t glyph)
+      : glyph_(glyph), dirty_(true)
     {
+      gen_.bump();
     }
 
-    Style& fg(Color color)
-    {
-      fg_ = static_cast<uint32_t>(color);
-      dirty_ = true;
-      return *this;
-    }
-    Style& bg(Color color)
-    {
-      bg_ = static_cast<uint32_t>(color);
-      dirty_ = true;
-      return *this;
-    }
-    Style& base(Color color)
+    Part& glyph(const uint32_t glyph)
     {
-      base_ = static_cast<uint32_t>(color);
-      dirty_ = true;
+      set(glyph_, glyph);
       return *this;
     }
 
-    Style& fg(const Rgb rgb)
-    {
-      fg_ = rgb.toHex() | (1u << 24);
-      dirty_ = true;
-      return *this;
-    }
-    Style& bg(const Rgb rgb)
+    Part& fg(const Color color)
     {
-      bg_ = rgb.toHex() | (1u << 24);
-      dirty_ = true;
+      set(fg_, static_cast<uint32_t>(color));
       return *this;
     }
-    Style& base(const Rgb rgb)
+    Part& fg(const Rgb rgb)
     {
-      base_ = rgb.toHex() | (1u << 24);
-      dirty_ = true;
+      set(fg_, rgb.toHex() | (1u << 24));
       return *this;
     }
 
-    Style& attrs(Attr attr)
+    Part& bg(const Color color)
     {
-      attrs_ |= static_cast<uint16_t>(attr);
-      dirty_ = true;
+      set(bg_, static_cast<uint32_t>(color));
       return *this;
     }
-    Style& attrs(const Style& attr)
+    Part& bg(const Rgb rgb)
     {
-      attrs_ |= attr.attrs_;
-      dirty_ = true;
+      set(bg_, rgb.toHex() | (1u << 24));
       return *this;
     }
 
-    bool hasFg() const { return fg_ != 0; }
-    bool hasBg() const { return bg_ != 0; }
-    bool hasBase() const { return base_ != 0; }
-    bool hasAttrs() const { return attrs_ != 0; }
-
-    uint32_t fg() const { return fg_; }
-    uint32_t bg() const { return bg_; }
-    uint32_t base() const { return base_; }
-    Attr attrs() const { return static_cast<Attr>(attrs_); }
-
-    void resetFg()
-    {
-      fg_ = 0;
-      dirty_ = true;
-    }
-    void resetBg()
-    {
-      bg_ = 0;
-      dirty_ = true;
-    }
-    void resetBase()
-    {
-      base_ = 0;
-      dirty_ = true;
-    }
-    void resetAttrs()
+    uint32_t fg() const
     {
-      attrs_ = 0;
-      dirty_ = true;
+      return fg_;
     }
-    void reset()
+    uint32_t bg() const
     {
-      fg_ = 0;
-      bg_ = 0;
-      base_ = 0;
-      attrs_ = 0;
-      dirty_ = true;
+      return bg_;
     }
-
-  private:
-    friend class Column;
-    bool& dirty_;
-
-    // representing all the colors
-    uint32_t fg_ = 0;
-    uint32_t bg_ = 0;
-    uint32_t base_ = 0;
-
-    // all the attributes
-    uint16_t attrs_ = 0;
-  };
-  class Config {
-  public:
-    explicit Config(bool& dirty_) : dirty_(dirty_)
+    uint32_t glyph() const
     {
+      return glyph_;
     }
 
-    Align align() const { return align_; }
-    Padd padd() const { return padd_; }
-    size_t width() const { return width_; }
-    std::string delimiter() const { return delimiter_; }
-    bool skipEmptyLineIndent() const { return skipEmptyLineIndent_; }
-
-    Config& align(const Align alignment)
+    Part& clrFg()
     {
-      align_ = alignment;
-      dirty_ = true;
+      set(fg_, 0u);
       return *this;
     }
-    Config& padd(const Padd padd)
+    Part& clrBg()
     {
-      padd_ = padd;
-      dirty_ = true;
+      set(bg_, 0u);
       return *this;
     }
-    Config& width(const size_t width)
+    Part& clr()
     {
-      width_ = width;
-      dirty_ = true;
+      set(fg_, 0u);
+      set(bg_, 0u);
       return *this;
     }
-    Config& delimiter(std::string delimiter)
+
+    bool operator==(const Part& other) const
     {
-      delimiter_ = std::move(delimiter);
-      dirty_ = true;
-      return *this;
+      return glyph_ == other.glyph_ && fg_ == other.fg_ && bg_ == other.bg_;
     }
-    Config& skipEmptyLineIndent(const bool skip)
+    bool operator!=(const Part& other) const { return !(*this == other); }
+
+    // changes whenever the part changes, see `detail::Generation`
+    uint64_t generation() const { return gen_; }
+
+    // appends `count` glyphs, the colors are set once for all of them
+    void fill(std::string& out, const size_t count) const
     {
-      skipEmptyLineIndent_ = skip;
-      dirty_ = true;
-      return *this;
+      if (count == 0) return;
+
+      const std::string& str = this->str();
+      const size_t suffix = str.size() - sgrSize_ - glyphSize_;
+
+      out.reserve(out.size() + str.size() + glyphSize_ * (count - 1));
+      out.append(str, 0, sgrSize_);
+      string_utils::repeat(out, str.data() + sgrSize_, glyphSize_, count);
+      out.append(str, str.size() - suffix, suffix);
     }
 
-    void reset()
+    explicit operator const std::string&() const { return str(); }
+    const std::string& str() const
     {
-      align_ = Align::Left;
-      padd_ = Padd();
-      delimiter_ = "-";
-      width_ = 0;
-      skipEmptyLineIndent_ = true;
-      dirty_ = true;
+      if (dirty_)
+      {
+        str_ = genStr();
+        dirty_ = false;
+      }
+
+      return str_;
     }
 
   private:
-    friend class Column;
-    bool& dirty_;
+    uint32_t glyph_ = 0; // Unicode code point
+    uint32_t fg_ = 0; // fg color
+    uint32_t bg_ = 0; // bg color
 
-    Align align_ = Align::Left;
-    Padd padd_ = Padd();
-    std::string delimiter_ = "-";
-    size_t width_ = 0;
-    bool skipEmptyLineIndent_ = true;
-  };
+    // the last change
+    detail::Generation gen_;
 
-public:
-  Column() = default;
+    // cache, with the sizes of the escape sequence and the glyph in it
+    mutable bool dirty_ = false;
+    mutable std::string str_;
+    mutable size_t sgrSize_ = 0;
+    mutable size_t glyphSize_ = 0;
 
-  Column(std::string content)
-    : content_(std::move(content)), dirty_(true)
-  {
-  }
+    void set(uint32_t& field, const uint32_t value)
+    {
+      if (field == value) return;
 
-  // copy constructor
-  // NOTE: if we don't initialize config_ and style_ with dirty_, and instead copy
-  // other.config_ and other.style_ we will get a heap-use-after-free error from the address sanitizer
-  // because config_ will still have the old dirty_ flag that points to the old object
-  // to avoid this we will initialize config_ and style_ with dirty_ of the current object
-  // and then copy the data of other.config_ and other.style_ one by one
-  // I didn't find a workaround solution except this :(
-  Column(const Column& other)
-    : lines_(other.lines_),
-    dirty_(other.dirty_),
-    config_(dirty_), // CRUCIAL
-    style_(dirty_), // CRUCIAL
-    content_(other.content_)
-  {
-    config_.align_ = other.config_.align_;
-    config_.padd_ = other.config_.padd_;
-    config_.delimiter_ = other.config_.delimiter_;
-    config_.width_ = other.config_.width_;
-    config_.skipEmptyLineIndent_ = other.config_.skipEmptyLineIndent_;
+      field = value;
+      gen_.bump();
+      dirty_ = true;
+    }
 
-    style_.fg_ = other.style_.fg_;
-    style_.bg_ = other.style_.bg_;
-    style_.base_ = other.style_.base_;
-    style_.attrs_ = other.style_.attrs_;
-  }
+    std::string genStr() const
+    {
+      using namespace detail;
+      std::string buffer;
 
-  void content(std::string content)
-  {
-    content_ = std::move(content);
-    dirty_ = true;
-  }
+      ColorType fg = fg_;
+      ColorType bg = bg_;
 
-  Config& config() { return config_; }
-  Style& style() { return style_; }
+      if (fg.isColor())
+      {
+        buffer.append("\x1b[");
+        buffer.append(std::to_string(static_cast<uint8_t>(fg.color())));
+        buffer.push_back(';');
+      }
+      else if (fg.isRgb())
+      {
+        Rgb rgb = fg.rgb();
+        buffer.append("\x1b[38;2;");
 
-  const Config& config() const { return config_; }
-  const Style& style() const { return style_; }
+        buffer.append(std::to_string(rgb.r));
+        buffer.push_back(';');
+        buffer.append(std::to_string(rgb.g));
+        buffer.push_back(';');
+        buffer.append(std::to_string(rgb.b));
+        buffer.push_back(';');
+      }
 
-  const std::string& content() const { return content_; }
-  std::string& content()
-  {
-    dirty_ = true;
-    return content_;
-  }
+      if (bg.isColor())
+      {
+        if (buffer.empty()) buffer.append("\x1b[");
+        buffer.append(std::to_string(static_cast<uint8_t>(bg.color()) + 10));
+        buffer.push_back(';');
+      }
+      else if (bg.isRgb())
+      {
+        Rgb rgb = bg.rgb();
+        buffer.append(buffer.empty() ? "\x1b[48;2;" : "48;2;");
+        buffer.append(std::to_string(rgb.r));
+        buffer.push_back(';');
+        buffer.append(std::to_string(rgb.g));
+        buffer.push_back(';');
+        buffer.append(std::to_string(rgb.b));
+        buffer.push_back(';');
+      }
 
-  explicit operator const std::string&() const
-  {
-    return content_;
-  }
-  explicit operator std::string&()
-  {
-    dirty_ = true;
-    return content_;
-  }
+      // terminate the sequence
+      if (!buffer.empty()) buffer.back() = 'm';
 
-  char& operator[](int index)
-  {
-    dirty_ = true;
-    return content_.at(index);
-  }
-  const char& operator[](int index) const
-  {
-    return content_.at(index);
-  }
+      const std::string glyph = glyphToStr();
+      sgrSize_ = buffer.size();
+      glyphSize_ = glyph.size();
+      buffer.append(glyph);
 
-  void clr()
-  {
-    content_.clear();
-    config_.reset();
-    style_.reset();
-    lines_.clear();
-    dirty_ = false;
-  }
+      if (buffer.length() - glyph.length() > 0)
+        buffer.append(RESET_ESC);
 
-  const std::vector<std::string>& lines() const
-  {
-    if (dirty_)
-    {
-      lines_ = genLines();
-      dirty_ = false;
+      return buffer;
     }
-    return lines_;
-  }
-  std::string genEmptyLine() const
-  {
-    const std::string base = resolveBase();
-    const size_t width = config().width();
-
-    std::string empty = base;
-    empty.reserve(width);
+    std::string glyphToStr() const
+    {
+      std::string result;
 
-    empty += std::string(width, ' ');
-    if (!base.empty()) empty += RESET_ESC;
+      if (glyph_ <= 0x7F)
+      {
+        result += static_cast<char>(glyph_);
+      }
 
-    return empty;
-  }
+      else if (glyph_ <= 0x7FF)
+      {
+        result += static_cast<char>(0xC0 | ((glyph_ >> 6) & 0x1F));
+        result += static_cast<char>(0x80 | (glyph_ & 0x3F));
+      }
 
-private:
-  // cache
-  mutable std::vector<std::string> lines_;
-  mutable bool dirty_ = false;
+      else if (glyph_ <= 0xFFFF)
+      {
+        result += static_cast<char>(0xE0 | ((glyph_ >> 12) & 0x0F));
+        result += static_cast<char>(0x80 | ((glyph_ >> 6) & 0x3F));
+        result += static_cast<char>(0x80 | (glyph_ & 0x3F));
+      }
 
-  Config config_{dirty_};
-  Style style_{dirty_};
-  std::string content_;
+      else
+      {
+        result += static_cast<char>(0xF0 | ((glyph_ >> 18) & 0x07));
+        result += static_cast<char>(0x80 | ((glyph_ >> 12) & 0x3F));
+        result += static_cast<char>(0x80 | ((glyph_ >> 6) & 0x3F));
+        result += static_cast<char>(0x80 | (glyph_ & 0x3F));
+      }
+
+      return result;
+    }
+  };
+
+  Part& horizontal() { return horizontal_; }
+  Part& vertical() { return vertical_; }
+  Part& cornerTopLeft() { return cornerTopLeft_; }
+  Part& cornerTopRight() { return cornerTopRight_; }
+  Part& cornerBottomLeft() { return cornerBottomLeft_; }
+  Part& cornerBottomRight() { return cornerBottomRight_; }
+  Part& intersection() { return intersection_; }
+  Part& connectorLeft() { return connectorLeft_; }
+  Part& connectorRight() { return connectorRight_; }
+  Part& connectorTop() { return connectorTop_; }
+  Part& connectorBottom() { return connectorBottom_; }
+
+  // changes whenever one of the parts changes
+  uint64_t generation() const
+  {
+    const Part* parts[] = {&horizontal_, &vertical_, &cornerTopLeft_,
+                           &cornerTopRight_, &cornerBottomLeft_,
+                           &cornerBottomRight_, &intersection_,
+                           &connectorLeft_, &connectorRight_, &connectorTop_,
+                           &connectorBottom_};
+
+    uint64_t generation = 0;
+    for (const Part* part : parts)
+      generation = (std::max)(generation, part->generation());
+
+    return generation;
+  }
+
+  const Part& horizontal() const { return horizontal_; }
+  const Part& vertical() const { return vertical_; }
+  const Part& cornerTopLeft() const { return cornerTopLeft_; }
+  const Part& cornerTopRight() const { return cornerTopRight_; }
+  const Part& cornerBottomLeft() const { return cornerBottomLeft_; }
+  const Part& cornerBottomRight() const { return cornerBottomRight_; }
+  const Part& intersection() const { return intersection_; }
+  const Part& connectorLeft() const { return connectorLeft_; }
+  const Part& connectorRight() const { return connectorRight_; }
+  const Part& connectorTop() const { return connectorTop_; }
+  const Part& connectorBottom() const { return connectorBottom_; }
+
+  Border& horizontal(const uint32_t glyph)
+  {
+    horizontal_.glyph(glyph);
+    return *this;
+  }
+  Border& vertical(const uint32_t glyph)
+  {
+    vertical_.glyph(glyph);
+    return *this;
+  }
+  Border& cornerTopLeft(const uint32_t glyph)
+  {
+    cornerTopLeft_.glyph(glyph);
+    return *this;
+  }
+  Border& cornerTopRight(const uint32_t glyph)
+  {
+    cornerTopRight_.glyph(glyph);
+    return *this;
+  }
+  Border& cornerBottomLeft(const uint32_t glyph)
+  {
+    cornerBottomLeft_.glyph(glyph);
+    return *this;
+  }
+  Border& cornerBottomRight(const uint32_t glyph)
+  {
+    cornerBottomRight_.glyph(glyph);
+    return *this;
+  }
+  Border& intersection(const uint32_t glyph)
+  {
+    intersection_.glyph(glyph);
+    return *this;
+  }
+  Border& connectorLeft(const uint32_t glyph)
+  {
+    connectorLeft_.glyph(glyph);
+    return *this;
+  }
+  Border& connectorRight(const uint32_t glyph)
+  {
+    connectorRight_.glyph(glyph);
+    return *this;
+  }
+  Border& connectorTop(const uint32_t glyph)
+  {
+    connectorTop_.glyph(glyph);
+    return *this;
+  }
+  Border& connectorBottom(const uint32_t glyph)
+  {
+    connectorBottom_.glyph(glyph);
+    return *this;
+  }
+
+  static Border Default()
+  {
+    // already default constructed
+    return {};
+  }
+  static Border Filled(const uint32_t c)
+  {
+    Border border;
+    border.horizontal_ = c;
+    border.vertical_ = c;
+
+    border.cornerTopLeft_ = c;
+    border.cornerTopRight_ = c;
+    border.cornerBottomLeft_ = c;
+    border.cornerBottomRight_ = c;
+
+    border.intersection_ = c;
+
+    border.connectorLeft_ = c;
+    border.connectorRight_ = c;
+    border.connectorTop_ = c;
+    border.connectorBottom_ = c;
+
+    return border;
+  }
+  static Border None()
+  {
+    return Filled(U'\0');
+  }
+  static Border Blank()
+  {
+    return Filled(U' ');
+  }
+  static Border Modern()
+  {
+    Border border;
+    border.horizontal_ = U'─';
+    border.vertical_ = U'│';
+
+    border.cornerTopLeft_ = U'┌';
+    border.cornerTopRight_ = U'┐';
+    border.cornerBottomLeft_ = U'└';
+    border.cornerBottomRight_ = U'┘';
+
+    border.intersection_ = U'┼';
+
+    border.connectorLeft_ = U'├';
+    border.connectorRight_ = U'┤';
+    border.connectorTop_ = U'┬';
+    border.connectorBottom_ = U'┴';
+
+    return border;
+  }
+  static Border Double()
+  {
+    Border border;
+    border.horizontal_ = U'═';
+    border.vertical_ = U'║';
+
+    border.cornerTopLeft_ = U'╔';
+    border.cornerTopRight_ = U'╗';
+    border.cornerBottomLeft_ = U'╚';
+    border.cornerBottomRight_ = U'╝';
+
+    border.intersection_ = U'╬';
+
+    border.connectorLeft_ = U'╠';
+    border.connectorRight_ = U'╣';
+    border.connectorTop_ = U'╦';
+    border.connectorBottom_ = U'╩';
+
+    return border;
+  }
+  static Border Rounded()
+  {
+    Border border;
+    border.horizontal_ = U'─';
+    border.vertical_ = U'│';
+
+    border.cornerTopLeft_ = U'╭';
+    border.cornerTopRight_ = U'╮';
+    border.cornerBottomLeft_ = U'╰';
+    border.cornerBottomRight_ = U'╯';
+
+    border.intersection_ = U'┼';
+
+    border.connectorLeft_ = U'├';
+    border.connectorRight_ = U'┤';
+    border.connectorTop_ = U'┬';
+    border.connectorBottom_ = U'┴';
+
+    return border;
+  }
+  static Border Heavy()
+  {
+    Border border;
+    border.horizontal_ = U'━';
+    border.vertical_ = U'┃';
+
+    border.cornerTopLeft_ = U'┏';
+    border.cornerTopRight_ = U'┓';
+    border.cornerBottomLeft_ = U'┗';
+    border.cornerBottomRight_ = U'┛';
+
+    border.intersection_ = U'╋';
+
+    border.connectorLeft_ = U'┣';
+    border.connectorRight_ = U'┫';
+    border.connectorTop_ = U'┳';
+    border.connectorBottom_ = U'┻';
+
+    return border;
+  }
+
+  void reset()
+  {
+    horizontal_ = U'-'; // ─
+    vertical_ = U'|'; // │
+
+    cornerTopLeft_ = U'+'; // ┌
+    cornerTopRight_ = U'+'; // ┐
+    cornerBottomLeft_ = U'+'; // └
+    cornerBottomRight_ = U'+'; // ┘
+
+    intersection_ = U'+'; // ┼
+
+    connectorLeft_ = U'+'; // ├
+    connectorRight_ = U'+'; // ┤
+    connectorTop_ = U'-'; // ┬
+    connectorBottom_ = U'-'; // ┴
+  }
+
+private:
+  Part horizontal_ = U'-'; // ─
+  Part vertical_ = U'|'; // │
+
+  Part cornerTopLeft_ = U'+'; // ┌
+  Part cornerTopRight_ = U'+'; // ┐
+  Part cornerBottomLeft_ = U'+'; // └
+  Part cornerBottomRight_ = U'+'; // ┘
+
+  Part intersection_ = U'+'; // ┼
+
+  Part connectorLeft_ = U'+'; // ├
+  Part connectorRight_ = U'+'; // ┤
+  Part connectorTop_ = U'-'; // ┬
+  Part connectorBottom_ = U'-'; // ┴
+};
+// clang-format on
+}
+
+namespace tabular {
+namespace detail {
+struct Str {
+  std::string str;
+  size_t dw;
+};
+
+// a piece of the column's content, it refers to the content instead of
+// copying it, so the wrapper walks the content without any allocation
+struct Token {
+  enum class Kind : uint8_t {
+    Word,    // visible characters
+    Space,   // ' '
+    Newline, // '\n'
+    Escape,  // SGR escape sequence ("\x1b[...m")
+    Reset,   // "\x1b[0m"
+    Ignored, // other space characters and escape sequences
+  };
+
+  size_t offset;
+  size_t length;
+  size_t dw;
+  Kind kind;
+};
+
+// what the content of a column is made of, computed once per content change
+// so the wrapper and the layout don't have to measure the content again
+struct ContentInfo {
+  bool ascii = true;        // only printable ascii and space characters
+  bool hasEscapes = false;  // escape sequences ("\x1b[...")
+  bool hasNewlines = false; // '\n'
+  bool hasSpaces = false;   // space characters other than ' ' and '\n'
+
+  size_t dw = 0;           // the display width of the whole content
+  size_t longestLine = 0;  // the display width of the widest line
+  size_t longestToken = 0; // the display width of the widest word
+};
+
+// the graphic rendition set by the SGR escape sequences ("\x1b[...m") of the
+// content, colors are encoded the same way `Column::Style` does, and 256
+// colors palette indexes are marked with the 26th bit
+struct Sgr {
+  // the background was explicitly reset ("\x1b[49m"), it must be restored
+  // because the column's base color is applied before the line's content
+  constexpr static uint32_t defaultBg = 1u << 26;
+
+  uint32_t fg = 0;
+  uint32_t bg = 0;
+  uint16_t attrs = 0;
+
+  bool empty() const { return fg == 0 && bg == 0 && attrs == 0; }
+  void reset()
+  {
+    fg = 0;
+    bg = 0;
+    attrs = 0;
+  }
+
+  // apply the parameters of an SGR escape sequence to the current state
+  // NOTE: parameters that aren't colors or `Attr`s are ignored
+  void apply(const char* esc, const size_t len)
+  {
+    if (len < 3 || esc[1] != '[') return;
+
+    size_t i = 2;
+    const size_t end = len - 1; // the final 'm'
+
+    // read the next parameter, an empty one is 0
+    auto next = [&]() -> uint32_t {
+      uint32_t value = 0;
+      for (; i < end && esc[i] != ';'; ++i)
+      {
+        if (esc[i] >= '0' && esc[i] <= '9')
+          value = value * 10 + static_cast<uint32_t>(esc[i] - '0');
+      }
+      ++i; // skip ';'
+      return value;
+    };
+
+    // 38;5;n / 48;5;n and 38;2;r;g;b / 48;2;r;g;b
+    auto extended = [&]() -> uint32_t {
+      const uint32_t mode = next();
+      if (mode == 5) return (next() & 0xFF) | (1u << 25);
+      if (mode != 2) return 0;
+
+      const uint32_t r = next() & 0xFF;
+      const uint32_t g = next() & 0xFF;
+      const uint32_t b = next() & 0xFF;
+      return ((r << 16) | (g << 8) | b) | (1u << 24);
+    };
+
+    auto set = [&](Attr attr) { attrs |= static_cast<uint16_t>(attr); };
+    auto clr = [&](Attr attr) {
+      attrs &= static_cast<uint16_t>(~static_cast<uint16_t>(attr));
+    };
+
+    while (i <= end)
+    {
+      const uint32_t code = next();
+
+      if ((code >= 30 && code <= 37) || (code >= 90 && code <= 97)) fg = code;
+      else if ((code >= 40 && code <= 47) || (code >= 100 && code <= 107))
+        bg = code - 10; // stored as the foreground color, like `Column::Style`
+      else
+      {
+        switch (code)
+        {
+        case 0: reset(); break;
+        case 1: set(Attr::Bold); break;
+        case 2: set(Attr::Dim); break;
+        case 3: set(Attr::Italic); break;
+        case 4: set(Attr::Underline); break;
+        case 5: set(Attr::Blink); break;
+        case 6: set(Attr::Flink); break;
+        case 7: set(Attr::Reverse); break;
+        case 8: set(Attr::Concealed); break;
+        case 9: set(Attr::Crossed); break;
+        case 21: set(Attr::Dunderline); break;
+        case 22: clr(Attr::Bold); clr(Attr::Dim); break;
+        case 23: clr(Attr::Italic); break;
+        case 24: clr(Attr::Underline); clr(Attr::Dunderline); break;
+        case 25: clr(Attr::Blink); clr(Attr::Flink); break;
+        case 27: clr(Attr::Reverse); break;
+        case 28: clr(Attr::Concealed); break;
+        case 29: clr(Attr::Crossed); break;
+        case 38: fg = extended(); break;
+        case 39: fg = 0; break;
+        case 48: bg = extended(); break;
+        case 49: bg = defaultBg; break;
+        default: break;
+        }
+      }
+    }
+  }
+};
+} // namespace detail
+// clang-format off
+class Column {
+public:
+  class Style {
+  public:
+    Style& fg(Color color)
+    {
+      detail::assign(fg_, static_cast<uint32_t>(color), gen_);
+      return *this;
+    }
+    Style& bg(Color color)
+    {
+      detail::assign(bg_, static_cast<uint32_t>(color), gen_);
+      return *this;
+    }
+    Style& base(Color color)
+    {
+      detail::assign(base_, static_cast<uint32_t>(color), gen_);
+      return *this;
+    }
+
+    Style& fg(const Rgb rgb)
+    {
+      detail::assign(fg_, rgb.toHex() | (1u << 24), gen_);
+      return *this;
+    }
+    Style& bg(const Rgb rgb)
+    {
+      detail::assign(bg_, rgb.toHex() | (1u << 24), gen_);
+      return *this;
+    }
+    Style& base(const Rgb rgb)
+    {
+      detail::assign(base_, rgb.toHex() | (1u << 24), gen_);
+      return *this;
+    }
+
+    Style& attrs(Attr attr)
+    {
+      const uint16_t attrs = attrs_ | static_cast<uint16_t>(attr);
+      detail::assign(attrs_, attrs, gen_);
+      return *this;
+    }
+    Style& attrs(const Style& attr)
+    {
+      const uint16_t attrs = attrs_ | attr.attrs_;
+      detail::assign(attrs_, attrs, gen_);
+      return *this;
+    }
+
+    bool hasFg() const { return fg_ != 0; }
+    bool hasBg() const { return bg_ != 0; }
+    bool hasBase() const { return base_ != 0; }
+    bool hasAttrs() const { return attrs_ != 0; }
+
+    uint32_t fg() const { return fg_; }
+    uint32_t bg() const { return bg_; }
+    uint32_t base() const { return base_; }
+    Attr attrs() const { return static_cast<Attr>(attrs_); }
+
+    void resetFg()
+    {
+      detail::assign(fg_, 0u, gen_);
+    }
+    void resetBg()
+    {
+      detail::assign(bg_, 0u, gen_);
+    }
+    void resetBase()
+    {
+      detail::assign(base_, 0u, gen_);
+    }
+    void resetAttrs()
+    {
+      detail::assign(attrs_, static_cast<uint16_t>(0), gen_);
+    }
+    void reset()
+    {
+      resetFg();
+      resetBg();
+      resetBase();
+      resetAttrs();
+    }
+
+  private:
+    friend class Column;
+
+    // the last change, see `detail::Generation`
+    detail::Generation gen_;
+
+    // representing all the colors
+    uint32_t fg_ = 0;
+    uint32_t bg_ = 0;
+    uint32_t base_ = 0;
+
+    // all the attributes
+    uint16_t attrs_ = 0;
+  };
+  class Config {
+  public:
+    Align align() const { return align_; }
+    Padd padd() const { return padd_; }
+    size_t width() const { return width_; }
+    std::string delimiter() const { return delimiter_; }
+    bool skipEmptyLineIndent() const { return skipEmptyLineIndent_; }
+
+    Config& align(const Align alignment)
+    {
+      detail::assign(align_, alignment, gen_);
+      return *this;
+    }
+    Config& padd(const Padd padd)
+    {
+      detail::assign(padd_, padd, gen_);
+      return *this;
+    }
+    Config& width(const size_t width)
+    {
+      detail::assign(width_, width, gen_);
+      return *this;
+    }
+    Config& delimiter(std::string delimiter)
+    {
+      detail::assign(delimiter_, std::move(delimiter), gen_);
+      return *this;
+    }
+    Config& skipEmptyLineIndent(const bool skip)
+    {
+      detail::assign(skipEmptyLineIndent_, skip, gen_);
+      return *this;
+    }
+
+    void reset()
+    {
+      align(Align::Left);
+      padd(Padd());
+      delimiter("-");
+      width(0);
+      skipEmptyLineIndent(true);
+    }
+
+  private:
+    friend class Column;
+
+    // the last change, see `detail::Generation`
+    detail::Generation gen_;
+
+    Align align_ = Align::Left;
+    Padd padd_ = Padd();
+    std::string delimiter_ = "-";
+    size_t width_ = 0;
+    bool skipEmptyLineIndent_ = true;
+  };
+
+  // the content handed out by the mutable accessors, reading it isn't a
+  // change, writing through it is
+  class Content {
+  public:
+    operator const std::string&() const { return column_.content_; }
+    const std::string& str() const { return column_.content_; }
+
+    Content& operator=(std::string content)
+    {
+      column_.content(std::move(content));
+      return *this;
+    }
+    Content& operator+=(const std::string& str)
+    {
+      if (!str.empty()) column_.edit([&str](std::string& content) { content += str; });
+      return *this;
+    }
+    Content& operator+=(const char c)
+    {
+      column_.edit([c](std::string& content) { content += c; });
+      return *this;
+    }
+
+    size_t size() const { return column_.content_.size(); }
+    size_t length() const { return column_.content_.length(); }
+    bool empty() const { return column_.content_.empty(); }
+    const char* c_str() const { return column_.content_.c_str(); }
+    const char* data() const { return column_.content_.data(); }
+    char operator[](const size_t index) const { return column_.content_[index]; }
+
+    friend bool operator==(const Content& a, const Content& b) { return a.str() == b.str(); }
+    friend bool operator==(const Content& a, const std::string& b) { return a.str() == b; }
+    friend bool operator==(const std::string& a, const Content& b) { return a == b.str(); }
+    friend bool operator!=(const Content& a, const Content& b) { return a.str() != b.str(); }
+    friend bool operator!=(const Content& a, const std::string& b) { return a.str() != b; }
+    friend bool operator!=(const std::string& a, const Content& b) { return a != b.str(); }
+    friend bool operator<(const Content& a, const Content& b) { return a.str() < b.str(); }
+
+    friend std::ostream& operator<<(std::ostream& out, const Content& content)
+    {
+      return out << content.str();
+    }
+
+  private:
+    friend class Column;
+    Column& column_;
+
+    explicit Content(Column& column)
+      : column_(column)
+    {
+    }
+  };
+
+  // a character of the content, see `Content`
+  class Char {
+  public:
+    operator char() const { return column_.content_[index_]; }
+
+    Char& operator=(const char c)
+    {
+      if (c != column_.content_[index_])
+        column_.edit([this, c](std::string& content) { content[index_] = c; });
+      return *this;
+    }
+
+  private:
+    friend class Column;
+    Column& column_;
+    size_t index_;
+
+    Char(Column& column, const size_t index)
+      : column_(column), index_(index)
+    {
+    }
+  };
+
+public:
+  Column() = default;
+
+  Column(std::string content)
+    : content_(std::move(content))
+  {
+    gen_.bump();
+  }
+
+  Column(const Column&) = default;
+  Column(Column&&) noexcept = default;
+  Column& operator=(const Column&) = default;
+  Column& operator=(Column&&) noexcept = default;
+
+  void content(std::string content)
+  {
+    if (content == content_) return;
+
+    content_ = std::move(content);
+    gen_.bump();
+    infoDirty_ = true;
+  }
+
+  // changes the content in place with `edit(std::string&)`, e.g. to append
+  // to a long content without copying it
+  template <typename Edit> void edit(Edit&& edit)
+  {
+    edit(content_);
+    gen_.bump();
+    infoDirty_ = true;
+  }
+
+  Config& config() { return config_; }
+  Style& style() { return style_; }
+
+  const Config& config() const { return config_; }
+  const Style& style() const { return style_; }
+
+  // the mutable content isn't a change by itself, only what's written
+  // through it is, see `Content`
+  const std::string& content() const { return content_; }
+  Content content() { return Content(*this); }
+
+  explicit operator const std::string&() const
+  {
+    return content_;
+  }
+
+  Char operator[](int index)
+  {
+    content_.at(index); // throws if out of range
+    return Char(*this, static_cast<size_t>(index));
+  }
+  const char& operator[](int index) const
+  {
+    return content_.at(index);
+  }
+
+  void clr()
+  {
+    content(std::string());
+    config_.reset();
+    style_.reset();
+    lines_.clear();
+    linesWidth_ = 0;
+    linesGen_ = generation();
+  }
+
+  // changes whenever the content, the configuration or the style changes
+  uint64_t generation() const
+  {
+    return (std::max)(gen_, (std::max)(config_.gen_, style_.gen_));
+  }
+
+  const detail::ContentInfo& contentInfo() const
+  {
+    if (infoDirty_)
+    {
+      info_ = describe(content_);
+      infoDirty_ = false;
+    }
+    return info_;
+  }
+
+  // the narrowest width that doesn't break any word
+  size_t minWidth() const
+  {
+    const Padd padd = config().padd();
+    const size_t width = contentInfo().longestToken + padd.left + padd.right;
+
+    return (std::max)(width, static_cast<size_t>(MIN_COLUMN_WIDTH));
+  }
+
+  // the width that fits every line of the content without wrapping
+  size_t maxWidth() const
+  {
+    const Padd padd = config().padd();
+    const size_t width = contentInfo().longestLine + padd.left + padd.right;
+
+    return (std::max)(width, static_cast<size_t>(MIN_COLUMN_WIDTH));
+  }
+
+  const std::vector<std::string>& lines() const
+  {
+    return lines(config().width());
+  }
+
+  // the lines of the column wrapped in `width` instead of the configured
+  // width, the table lays the columns out this way without touching them
+  const std::vector<std::string>& lines(const size_t width) const
+  {
+    if (!cached(width))
+    {
+      lines_ = genLines(width);
+      linesWidth_ = width;
+      linesGen_ = generation();
+    }
+    return lines_;
+  }
+
+  std::string genEmptyLine() const
+  {
+    return genEmptyLine(config().width());
+  }
+  std::string genEmptyLine(const size_t width) const
+  {
+    const std::string base = resolveBase();
+
+    std::string empty = base;
+    empty.reserve(width);
+
+    empty += std::string(width, ' ');
+    if (!base.empty()) empty += RESET_ESC;
+
+    return empty;
+  }
+
+private:
+  // the row renders the columns without caching their lines
+  friend class Row;
+
+  // cache
+  mutable std::vector<std::string> lines_;
+  mutable size_t linesWidth_ = 0;
+  mutable uint64_t linesGen_ = 0;
+
+  // the last change of the content, see `detail::Generation`
+  detail::Generation gen_;
+
+  // content descriptor cache, only the content invalidates it
+  mutable detail::ContentInfo info_;
+  mutable bool infoDirty_ = true;
+
+  Config config_;
+  Style style_;
+  std::string content_;
+
+  bool cached(const size_t width) const
+  {
+    return linesGen_ == generation() && width == linesWidth_;
+  }
+  std::vector<std::string> genLines(const size_t columnWidth) const
+  {
+    std::string delimiter = config().delimiter();
+    size_t delimiterDw = string_utils::dw(delimiter);
+    Padd padd = config().padd();
+
+    size_t width = columnWidth;
+    if (width < MIN_COLUMN_WIDTH) width = MIN_COLUMN_WIDTH;
+
+    if (padd.right + padd.left >= width)
+    {
+      padd.right = 0;
+      padd.left = 0;
+    }
+
+    width -= (padd.left + padd.right);
+
+    if (delimiterDw >= width)
+    {
+      delimiter = "";
+      delimiterDw = 0;
+    }
+
+    // most cells are short values that fit in a single line, format them
+    // directly without splitting and wrapping
+    if (isSingleLine(width)) return formatSingleLine(padd, columnWidth);
+
+    // split the content into tokens
+    const auto tokens = tokenize(content_);
+
+    // wrap the tokens into lines
+    const std::vector<detail::Str> lines =
+        wrap(tokens, width, delimiter, delimiterDw);
+
+    // format the lines handling padding, alignment and the base styles
+    return format(lines, padd, columnWidth);
+  }
+  static void handleColor(std::string& styles, detail::ColorType colortype,
+                          bool back)
+  {
+    if (colortype.isColor())
+    {
+      Color c = colortype.color();
+      styles += std::to_string(static_cast<uint8_t>(c) + (back ? 10 : 0)) + ';';
+    }
+
+    else if (colortype.isRgb())
+    {
+      Rgb rgb = colortype.rgb();
+      styles += back ? "48;2;" : "38;2;";
+      styles += std::to_string(rgb.r) + ';';
+      styles += std::to_string(rgb.g) + ';';
+      styles += std::to_string(rgb.b) + ';';
+    }
+
+    else if (colortype.isPalette())
+    {
+      styles += back ? "48;5;" : "38;5;";
+      styles += std::to_string(colortype.palette()) + ';';
+    }
+  }
+  static void handleAttrs(std::string& styles, Attr attr)
+  {
+    auto hasAttr = [](Attr attr, Attr flag) -> bool {
+      return static_cast<uint16_t>(attr) & static_cast<uint16_t>(flag);
+    };
+
+    if (hasAttr(attr, Attr::Bold)) styles += "1;";
+    if (hasAttr(attr, Attr::Dim)) styles += "2;";
+    if (hasAttr(attr, Attr::Italic)) styles += "3;";
+    if (hasAttr(attr, Attr::Underline)) styles += "4;";
+    if (hasAttr(attr, Attr::Dunderline)) styles += "21;";
+    if (hasAttr(attr, Attr::Blink)) styles += "5;";
+    if (hasAttr(attr, Attr::Flink)) styles += "6;";
+    if (hasAttr(attr, Attr::Reverse)) styles += "7;";
+    if (hasAttr(attr, Attr::Concealed)) styles += "8;";
+    if (hasAttr(attr, Attr::Crossed)) styles += "9;";
+  }
+
+  static std::string resolveSgr(const detail::Sgr& sgr)
+  {
+    std::string styles = "\x1b[";
+
+    if (sgr.attrs != 0) handleAttrs(styles, static_cast<Attr>(sgr.attrs));
+
+    if (sgr.fg != 0) handleColor(styles, sgr.fg, false);
+
+    if (sgr.bg == detail::Sgr::defaultBg) styles += "49;";
+    else if (sgr.bg != 0) handleColor(styles, sgr.bg, true);
+
+    if (styles == "\x1b[") return ""; // empty
+
+    if (styles.back() == ';') styles.back() = 'm';
+    return styles;
+  }
+  detail::Sgr styleSgr() const
+  {
+    detail::Sgr sgr;
+    sgr.fg = style().fg();
+    sgr.bg = style().bg();
+    sgr.attrs = static_cast<uint16_t>(style().attrs());
+
+    return sgr;
+  }
+  std::string resolveStyles() const
+  {
+    return resolveSgr(styleSgr());
+  }
+  std::string resolveBase() const
+  {
+    std::string base = "\x1b[";
+    handleColor(base, style().base(), true);
+
+    if (base == "\x1b[") return ""; // empty
+
+    if (base.back() == ';') base.back() = 'm';
+    return base;
+  }
+
+  // whether the content is plain text (no escape sequences or special
+  // spaces) that fits in `width`
+  bool isSingleLine(const size_t width) const
+  {
+    const detail::ContentInfo& info = contentInfo();
+    if (content_.empty() || info.hasEscapes || info.hasNewlines || info.hasSpaces)
+      return false;
+
+    // leading spaces may be skipped, leave them to the wrapper
+    if (content_[0] == ' ' && config_.skipEmptyLineIndent()) return false;
+
+    return info.dw <= width;
+  }
+  static detail::ContentInfo describe(const std::string& str)
+  {
+    using namespace string_utils;
+
+    detail::ContentInfo info;
+
+    const char* ptr = str.data();
+    const char* end = ptr + str.length();
+
+    size_t lineDw = 0, tokenDw = 0;
+    auto endToken = [&]() {
+      if (tokenDw > info.longestToken) info.longestToken = tokenDw;
+      tokenDw = 0;
+    };
+    auto endLine = [&]() {
+      endToken();
+      if (lineDw > info.longestLine) info.longestLine = lineDw;
+      lineDw = 0;
+    };
+
+    while (ptr < end)
+    {
+      // printable ascii characters are 1 column each
+      const char* run = ptr + detail::asciiRun(ptr, end);
+      for (; ptr < run; ++ptr)
+      {
+        if (*ptr == ' ') endToken();
+        else ++tokenDw;
+
+        ++lineDw;
+        ++info.dw;
+      }
+
+      if (ptr == end) break;
+
+      if (*ptr == '\n')
+      {
+        info.hasNewlines = true;
+        endLine();
+        ++ptr;
+        continue;
+      }
+
+      // the wrapper ignores other space characters
+      if (isSpace(*ptr))
+      {
+        info.hasSpaces = true;
+        endToken();
+        ++ptr;
+        continue;
+      }
+
+      info.ascii = false;
+
+      // escape sequences split words, the same way `tokenize` reads them
+      if (*ptr == '\x1b')
+      {
+        info.hasEscapes = true;
+        endToken();
+
+        ++ptr;
+        while (ptr < end && isAscii(*ptr) && !isAlpha(*ptr))
+          ++ptr;
+
+        if (ptr < end) ++ptr;
+        continue;
+      }
+
+      // the same way `dw` measures the character, invalid bytes are 1 wide
+      size_t charDw = 1;
+      uint32_t wc;
+      int consumed = 1;
+      if (utf8twc(ptr, static_cast<size_t>(end - ptr), wc, consumed))
+      {
+        charDw = wcwidth(wc);
+        ptr += consumed;
+      }
+      else
+        ++ptr;
+
+      tokenDw += charDw;
+      lineDw += charDw;
+      info.dw += charDw;
+    }
+
+    endLine();
+    return info;
+  }
+  std::vector<detail::Token> tokenize(const std::string& str) const
+  {
+    using namespace string_utils;
+    using Kind = detail::Token::Kind;
+
+    const char* data = str.data();
+    const size_t len = str.length();
+
+    // the words of ascii content are as wide as they are long
+    const bool ascii = contentInfo().ascii;
+
+    std::vector<detail::Token> tokens;
+    tokens.reserve((len / WORD_LENGTH_AVERAGE) + 1); // average
+
+    auto push = [&](size_t offset, size_t length, Kind kind) {
+      const bool measured = ascii && kind == Kind::Word;
+      const size_t width = measured ? length : dw(data + offset, length);
+      tokens.push_back({offset, length, width, kind});
+    };
+
+    size_t start = 0; // the beginning of the current word
+    size_t i = 0;
+    while (i < len)
+    {
+      if (data[i] == '\x1b')
+      {
+        if (i > start) push(start, i - start, Kind::Word);
+        start = i;
+
+        while (i < len && isAscii(data[i]) && !isAlpha(data[i]))
+          ++i;
+
+        if (i < len) ++i;
+
+        Kind kind = Kind::Ignored;
+        if (data[i - 1] == 'm')
+        {
+          const bool reset = str.compare(start, i - start, RESET_ESC) == 0;
+          kind = reset ? Kind::Reset : Kind::Escape;
+        }
+
+        push(start, i - start, kind);
+        start = i;
+        continue;
+      }
+
+      if (isSpace(data[i]))
+      {
+        if (i > start) push(start, i - start, Kind::Word);
+
+        Kind kind = Kind::Ignored;
+        if (data[i] == ' ') kind = Kind::Space;
+        else if (data[i] == '\n') kind = Kind::Newline;
+
+        push(i, 1, kind);
+        start = ++i;
+        continue;
+      }
+
+      ++i;
+    }
+
+    if (i > start) push(start, i - start, Kind::Word);
+    return tokens;
+  }
+  std::vector<detail::Str> wrap(const std::vector<detail::Token>& tokens,
+                                const size_t width,
+                                const std::string& delimiter,
+                                const size_t delimiterDw) const
+  {
+    using namespace string_utils;
+    using Kind = detail::Token::Kind;
+
+    const std::string styles = resolveStyles();
+    const bool skipBlanks = config_.skipEmptyLineIndent();
+
+    std::vector<detail::Str> lines;
+    lines.reserve(content_.length() / width + 1);
+
+    std::string buffer;
+    size_t bufferDw = 0; // the display width
+
+    buffer.reserve(width);
+    if (!styles.empty()) buffer += styles;
+
+    // in case the line contains active escape sequences, and they were NOT
+    // reset (with '\x1b[0m'), we need to track them, reset them at the end
+    // of the line, and restore them in the next line. the column styles and
+    // the active escape sequences are restored with a single sequence.
+    const detail::Sgr base = styleSgr();
+    detail::Sgr active = base;
+    std::string activeEscs = styles;
+
+    // whether escape sequences were applied since the last reset, even if
+    // they cancel each other and `activeEscs` ends up empty
+    bool pending = false;
+
+    // whether the current line started with carried over escape sequences,
+    // the line is never considered empty then, even if `activeEscs` is
+    bool carried = false;
+
+    // helper lambdas to avoid repeating code
+    auto appendResetIfNeeded = [&]() {
+      if ((pending || !styles.empty()) && !endsWith(buffer, RESET_ESC))
+        buffer += RESET_ESC;
+    };
+    auto startNewLine = [&]() {
+      appendResetIfNeeded();
+      lines.push_back({buffer, bufferDw});
+
+      buffer.clear();
+      bufferDw = 0;
+
+      buffer += activeEscs;
+      carried = pending;
+    };
+
+    for (size_t i = 0; i < tokens.size(); ++i)
+    {
+      const detail::Token& token = tokens[i];
+      const char* word = content_.data() + token.offset;
+
+      // SKIP spaces at the start of a new line
+      if (skipBlanks && buffer.empty() && !carried && token.kind == Kind::Space)
+        continue;
+
+      // HANDLE new lines
+      if (token.kind == Kind::Newline)
+      {
+        startNewLine();
+        continue;
+      }
+
+      // IGNORE other space characters and escape sequences
+      if (token.kind == Kind::Ignored) continue;
+
+      // HANDLE escape sequences
+      if (token.kind == Kind::Escape || token.kind == Kind::Reset)
+      {
+        const bool nextFits =
+            i + 1 < tokens.size() && tokens[i + 1].dw + bufferDw <= width;
+
+        if (token.kind == Kind::Reset)
+        {
+          active = base;
+          activeEscs = styles;
+          pending = false;
+          buffer.append(word, token.length);
+
+          if (nextFits) buffer += styles;
+
+          continue;
+        }
+
+        active.apply(word, token.length);
+        activeEscs = resolveSgr(active);
+        pending = true;
+
+        if (nextFits) buffer.append(word, token.length);
+
+        continue;
+      }
+
+      // word display width
+      size_t wordDw = token.dw;
+
+      // the word fits in the line
+      if (wordDw + bufferDw <= width)
+      {
+        buffer.append(word, token.length);
+        bufferDw += wordDw;
+        continue;
+      }
+
+      // the word fits in the next line
+      if (wordDw <= width)
+      {
+        startNewLine();
+
+        // add the next word and avoid spaces
+        if (token.kind != Kind::Space)
+        {
+          buffer.append(word, token.length);
+          bufferDw += wordDw;
+        }
+
+        continue;
+      }
+
+      /*
+       * if we reach here that means the word's display width
+       * exceeds the line width
+       */
+
+      // no free space, append the current line and process the others
+      if (bufferDw >= width - delimiterDw) startNewLine();
+
+      // walk the word once, `start` is where the rest of it begins
+      const char* data = word;
+      const size_t len = token.length;
+      size_t start = 0;
+
+      while (wordDw > width)
+      {
+        const size_t limit = width - delimiterDw - bufferDw;
+
+        size_t partDw = 0;
+        size_t pos = start;
+        while (partDw < limit && pos < len)
+        {
+          // printable ascii characters are 1 column each, take them in bulk
+          const size_t room = (std::min)(limit - partDw, len - pos);
+          const size_t run = detail::asciiRun(data + pos, data + pos + room);
+          if (run > 0)
+          {
+            partDw += run;
+            pos += run;
+            continue;
+          }
+
+          // invalid bytes are taken one by one, the same way `dw` counts them
+          size_t charLen = utf8CharLen(data, len, pos);
+          if (charLen == 0) charLen = 1;
+
+          const size_t charDw = dw(data + pos, charLen);
+
+          // if it will exceed the limit don't append
+          if (charDw + partDw > limit)
+          {
+            // it doesn't fit even in an empty line, take it anyway to make
+            // progress, and drop the delimiter if there's no room for it
+            if (bufferDw == 0 && pos == start)
+            {
+              partDw += charDw;
+              pos += charLen;
+            }
+            break;
+          }
+
+          // otherwise append this part
+          partDw += charDw;
+          pos += charLen;
+        }
+
+        // add the part and the delimiter into the buffer
+        buffer.append(data + start, pos - start);
+        bufferDw += partDw;
+        wordDw -= partDw;
+
+        if (bufferDw + delimiterDw <= width)
+        {
+          buffer += delimiter;
+          bufferDw += delimiterDw;
+        }
+
+        start = pos;
+
+        // append a new line
+        startNewLine();
+      }
+
+      buffer.append(data + start, len - start);
+      bufferDw += wordDw;
+    }
+
+    if (!buffer.empty() || carried)
+    {
+      appendResetIfNeeded();
+      lines.push_back({buffer, bufferDw});
+    }
+
+    return lines;
+  }
+  std::vector<std::string> format(const std::vector<detail::Str>& lines,
+                                  const Padd padd, const size_t width) const
+  {
+    using namespace string_utils;
+
+    const std::string base = resolveBase();
+
+    std::vector<std::string> formatted;
+    formatted.reserve(lines.size() + padd.top + padd.bottom);
+
+    const bool styled = !base.empty();
+    const std::string empty = genEmptyLine(width);
+    formatted.insert(formatted.end(), padd.top, empty);
+
+    // temporary buffer
+    std::string buffer;
+    buffer.reserve(width);
+
+    for (const auto& line : lines)
+    {
+      // append the base styles
+      if (styled) buffer += base;
+
+      size_t leftSpace = 0, rightSpace = 0;
+      alignLine(line.dw, padd, width, leftSpace, rightSpace);
+
+      buffer.append(leftSpace + padd.left, ' ');
+      buffer += line.str;
+
+      if (endsWith(line.str, RESET_ESC)) buffer += base;
+
+      buffer.append(rightSpace + padd.right, ' ');
+
+      // reset the base styles
+      if (styled) buffer += RESET_ESC;
+
+      formatted.emplace_back(std::move(buffer));
+      buffer.clear();
+    }
+
+    formatted.insert(formatted.end(), padd.bottom, empty);
+    return formatted;
+  }
+  std::vector<std::string> formatSingleLine(const Padd padd,
+                                            const size_t width) const
+  {
+    const size_t contentDw = contentInfo().dw;
+    const std::string base = resolveBase();
+    const std::string styles = resolveStyles();
+    const size_t resetLen = std::char_traits<char>::length(RESET_ESC);
+
+    size_t leftSpace = 0, rightSpace = 0;
+    alignLine(contentDw, padd, width, leftSpace, rightSpace);
+
+    leftSpace += padd.left;
+    rightSpace += padd.right;
+
+    // the same layout `wrap` and `format` produce for a single line
+    size_t size = leftSpace + content_.length() + rightSpace;
+    if (!base.empty()) size += base.length() + resetLen;
+    if (!styles.empty()) size += styles.length() + resetLen + base.length();
+
+    std::string line;
+    line.reserve(size);
+
+    line += base;
+    line.append(leftSpace, ' ');
+
+    if (!styles.empty())
+    {
+      line += styles;
+      line += content_;
+      line += RESET_ESC;
+      line += base;
+    }
+    else
+      line += content_;
+
+    line.append(rightSpace, ' ');
+    if (!base.empty()) line += RESET_ESC;
+
+    std::vector<std::string> formatted;
+    formatted.reserve(1 + padd.top + padd.bottom);
+
+    if (padd.top + padd.bottom > 0)
+    {
+      const std::string empty = genEmptyLine(width);
+      formatted.insert(formatted.end(), padd.top, empty);
+      formatted.emplace_back(std::move(line));
+      formatted.insert(formatted.end(), padd.bottom, empty);
+    }
+    else
+      formatted.emplace_back(std::move(line));
+
+    return formatted;
+  }
+  // calculates the spaces around a line of display width `lineDw`
+  void alignLine(const size_t lineDw, const Padd padd, const size_t width,
+                 size_t& leftSpace, size_t& rightSpace) const
+  {
+    // calculate the total line width
+    const size_t lineWidth = lineDw + padd.left + padd.right;
+    const size_t freeSpace = (width > lineWidth) ? width - lineWidth : 0;
+
+    switch (config().align())
+    {
+    case Align::Left:
+      leftSpace = 0;
+      rightSpace = freeSpace;
+      break;
+    case Align::Center: {
+      leftSpace = freeSpace / 2;
+      rightSpace = freeSpace - leftSpace;
+      break;
+    }
+    case Align::Right:
+      leftSpace = freeSpace;
+      rightSpace = 0;
+      break;
+    }
+  }
+};
+// clang-format on
+
+inline Attr operator|(Attr lhs, Attr rhs) noexcept
+{
+  return static_cast<Attr>(static_cast<uint16_t>(lhs) |
+                                static_cast<uint16_t>(rhs));
+}
+
+inline Attr& operator|=(Attr& lhs, const Attr rhs) noexcept
+{
+  lhs = lhs | rhs;
+  return lhs;
+}
+} // namespace tabular
+
+namespace tabular {
+// clang-format off
+// the width of the columns at the same index in every row of a table, see
+// `Table::Config::columns()`. a column is either flexible, sharing the space
+// left by the others relative to its weight, fixed, or a percentage of the
+// space of all the columns (the table's width without the vertical borders).
+// any of them can be bounded with `min()` and `max()`
+class ColumnWidth {
+public:
+  enum class Kind { Flex, Fixed, Percent };
+
+  ColumnWidth() = default;
+
+  static ColumnWidth Flex(const size_t weight = 1)
+  {
+    return ColumnWidth(Kind::Flex, (std::max)(weight, size_t(1)));
+  }
+  static ColumnWidth Fixed(const size_t width)
+  {
+    return ColumnWidth(Kind::Fixed, width);
+  }
+  static ColumnWidth Percent(const size_t percent)
+  {
+    return ColumnWidth(Kind::Percent, (std::min)(percent, size_t(100)));
+  }
+
+  ColumnWidth& min(const size_t width)
+  {
+    min_ = width;
+    return *this;
+  }
+  ColumnWidth& max(const size_t width)
+  {
+    max_ = width;
+    return *this;
+  }
+
+  Kind kind() const { return kind_; }
+
+  // the weight, the width or the percentage
+  size_t value() const { return value_; }
+
+  // zero if unbounded
+  size_t min() const { return min_; }
+  size_t max() const { return max_; }
+
+  bool operator==(const ColumnWidth& other) const
+  {
+    return kind_ == other.kind_ && value_ == other.value_ &&
+           min_ == other.min_ && max_ == other.max_;
+  }
+  bool operator!=(const ColumnWidth& other) const { return !(*this == other); }
+
+private:
+  Kind kind_ = Kind::Flex;
+  size_t value_ = 1;
+  size_t min_ = 0;
+  size_t max_ = 0;
+
+  ColumnWidth(const Kind kind, const size_t value)
+    : kind_(kind), value_(value)
+  {
+  }
+};
+// clang-format on
+
+namespace detail {
+// the widths of `columns` columns sharing `available`, the columns past the
+// end of `spec` are flexible. throws if they can't fit
+inline std::vector<size_t> resolveWidths(const std::vector<ColumnWidth>& spec,
+                                         const size_t columns,
+                                         const size_t available)
+{
+  std::vector<size_t> widths(columns, 0);
+  std::vector<size_t> lows(columns, MIN_COLUMN_WIDTH);
+  std::vector<size_t> highs(columns, available);
+  std::vector<bool> flexible(columns, true);
+  std::vector<bool> fixed(columns, false);
+
+  size_t used = 0;
+  for (size_t i = 0; i < columns; ++i)
+  {
+    const ColumnWidth width = i < spec.size() ? spec[i] : ColumnWidth();
+
+    lows[i] = (std::max)(lows[i], width.min());
+    if (width.max() != 0) highs[i] = (std::max)(width.max(), lows[i]);
+
+    if (width.kind() == ColumnWidth::Kind::Flex) continue;
+
+    size_t w = width.value();
+    if (width.kind() == ColumnWidth::Kind::Percent)
+      w = available * width.value() / 100;
+
+    // a fixed width wider than the table throws below instead of shrinking
+    widths[i] = (std::max)(w, lows[i]);
+    if (width.max() != 0) widths[i] = (std::min)(widths[i], highs[i]);
+
+    flexible[i] = false;
+    fixed[i] = width.kind() == ColumnWidth::Kind::Fixed;
+    used += widths[i];
+  }
+
+  // the flexible columns share the rest relative to their weights, the ones
+  // that hit a bound take it and the others share again what's left
+  std::vector<bool> frozen(flexible);
+  frozen.flip();
+
+  while (true)
+  {
+    size_t weights = 0, space = available;
+    for (size_t i = 0; i < columns; ++i)
+    {
+      if (!frozen[i]) weights += i < spec.size() ? spec[i].value() : 1;
+      else space -= (std::min)(space, widths[i]);
+    }
+
+    if (weights == 0) break;
+
+    bool clamped = false;
+    for (size_t i = 0; i < columns; ++i)
+    {
+      if (frozen[i]) continue;
+
+      const size_t weight = i < spec.size() ? spec[i].value() : 1;
+      const size_t w = space * weight / weights;
+
+      widths[i] = (std::min)((std::max)(w, lows[i]), highs[i]);
+      if (widths[i] != w)
+      {
+        frozen[i] = true;
+        clamped = true;
+      }
+    }
+
+    if (!clamped) break;
+  }
+
+  used = 0;
+  for (const size_t w : widths)
+    used += w;
+
+  if (used > available)
+  {
+    throw std::runtime_error(
+      "layout error: the columns must have a minimum width of " +
+      std::to_string(used) + ", but found " + std::to_string(available));
+  }
+
+  // the rounding leftovers go to the flexible columns, or else to the
+  // percentage ones, the fixed ones never grow. what no column can take is
+  // left out, the table is narrower than its width then
+  for (const bool percent : {false, true})
+  {
+    auto taker = [&](const size_t i) {
+      return (flexible[i] || (percent && !fixed[i])) && widths[i] < highs[i];
+    };
+
+    size_t takers = 0;
+    for (size_t i = 0; i < columns; ++i)
+      takers += taker(i);
+
+    for (size_t i = 0; takers > 0 && used < available; i = (i + 1) % columns)
+    {
+      if (!taker(i)) continue;
+
+      widths[i]++;
+      used++;
+      if (widths[i] >= highs[i]) takers--;
+    }
+  }
+
+  return widths;
+}
+} // namespace detail
+} // namespace tabular
+
+namespace tabular {
+// runs `task(0)`, ..., `task(count - 1)` and returns once they're all done,
+// e.g. by handing them to a thread pool, see `Table::Config::executor()`
+using Executor =
+  std::function<void(size_t count, const std::function<void(size_t)>& task)>;
+
+namespace detail {
+// runs the tasks on the given executor, or on up to `threads` threads with
+// the calling one included. the first exception thrown by a task is thrown
+// again once they're all done
+inline void parallelFor(const Executor* executor, size_t threads,
+                        const size_t count,
+                        const std::function<void(size_t)>& task)
+{
+  std::exception_ptr error;
+  std::mutex mutex;
+
+  auto guarded = [&](const size_t index) {
+    try
+    {
+      task(index);
+    }
+    catch (...)
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      if (!error) error = std::current_exception();
+    }
+  };
+
+  if (executor != nullptr)
+    (*executor)(count, guarded);
+
+  else
+  {
+    std::atomic<size_t> next{0};
+    auto work = [&]() {
+      for (size_t i = next++; i < count; i = next++)
+        guarded(i);
+    };
+
+    std::vector<std::thread> workers;
+    threads = (std::min)(threads, count);
+    workers.reserve(threads);
+
+    // fewer threads if the system refuses to start them
+    try
+    {
+      for (size_t i = 1; i < threads; ++i)
+        workers.emplace_back(work);
+    }
+    catch (const std::system_error&)
+    {
+    }
+
+    work();
+    for (auto& worker : workers)
+      worker.join();
+  }
+
+  if (error) std::rethrow_exception(error);
+}
+} // namespace detail
+} // namespace tabular
+
+namespace tabular {
+// clang-format off
+class Row {
+public:
+  class Config {
+  public:
+    void hasBottom(bool has)
+    {
+      detail::assign(hasBottom_, has, gen_);
+    }
+    void vertical(Border::Part part)
+    {
+      detail::assign(vertical_, std::move(part), gen_);
+    }
+
+    bool hasBottom() const { return hasBottom_; }
+    const Border::Part& vertical() const { return vertical_; }
+
+    void reset()
+    {
+      vertical(0);
+    }
+
+  private:
+    friend class Row;
+
+    // the last change, see `detail::Generation`
+    detail::Generation gen_;
+
+    bool hasBottom_ = true;
+    Border::Part vertical_ = 0;
+  };
+
+public:
+  Row() = default;
+
+  Row(const Row&) = default;
+  Row(Row&&) noexcept = default;
+  Row& operator=(const Row&) = default;
+  Row& operator=(Row&&) noexcept = default;
+
+  explicit Row(std::vector<Column> columns)
+    : columns_(std::move(columns))
+  {
+  }
+  explicit Row(std::vector<std::string> columns)
+  {
+    columns_.reserve(columns.size());
+
+    for (auto& column : columns)
+    {
+      columns_.emplace_back(std::move(column));
+    }
+  }
+
+  void columns(std::vector<Column> columns)
+  {
+    gen_.bump();
+    columns_ = std::move(columns);
+  }
+
+  Config& config() { return config_; }
+  const Config& config() const { return config_; }
+
+  // the columns track their own changes, handing them out isn't a change
+  std::vector<Column>& columns() { return columns_; }
+  const std::vector<Column>& columns() const { return columns_; }
+
+  Column& column(int index)
+  {
+    return columns_.at(index);
+  }
+  const Column& column(int index) const
+  {
+    return columns_.at(index);
+  }
+
+  Column& operator[](int index)
+  {
+    return columns_.at(index);
+  }
+  const Column& operator[](int index) const
+  {
+    return columns_.at(index);
+  }
+
+  void clr()
+  {
+    columns_.clear();
+    str_.clear();
+    strWidths_.clear();
+    strVertical_.clear();
+    config_.reset();
+    gen_.bump();
+    strGen_ = generation();
+  }
+
+  // changes whenever the row, its configuration or one of its columns
+  // changes
+  uint64_t generation() const
+  {
+    uint64_t generation = (std::max)(gen_, config_.gen_);
+
+    for (const auto& column : columns_)
+      generation = (std::max)(generation, column.generation());
+
+    return generation;
+  }
+
+  const std::string& str() const
+  {
+    std::vector<size_t> widths;
+    widths.reserve(columns_.size());
+
+    for (const auto& column : columns_)
+      widths.push_back(column.config().width());
+
+    return str(widths, config().vertical());
+  }
+
+  // the row laid out with the given column widths and vertical border,
+  // instead of the columns' and the row's own configuration
+  const std::string& str(const std::vector<size_t>& widths,
+                         const Border::Part& vertical) const
+  {
+    const std::string& verticalStr = vertical.str();
+    if (!cached(widths, verticalStr))
+    {
+      str_.clear();
+      genStr(str_, widths, verticalStr, true);
+      strWidths_ = widths;
+      strVertical_ = verticalStr;
+      strGen_ = generation();
+    }
+
+    return str_;
+  }
 
-  std::vector<std::string> genLines() const
+  // appends the row laid out like `str(widths, vertical)` to `out`, nothing
+  // is cached, neither the row nor the columns lines, unless it already is
+  void write(std::string& out, const std::vector<size_t>& widths,
+             const Border::Part& vertical) const
   {
-    std::string delimiter = config().delimiter();
-    size_t delimiterDw = string_utils::dw(delimiter);
-    Padd padd = config().padd();
+    const std::string& verticalStr = vertical.str();
 
-    size_t width = config().width();
-    if (width < MIN_COLUMN_WIDTH) width = MIN_COLUMN_WIDTH;
+    if (cached(widths, verticalStr)) out += str_;
+    else genStr(out, widths, verticalStr, false);
+  }
 
-    if (padd.right + padd.left >= width)
+private:
+  // cache
+  mutable std::string str_;
+  mutable uint64_t strGen_ = 0;
+
+  // the layout `str_` was generated with
+  mutable std::vector<size_t> strWidths_;
+  mutable std::string strVertical_;
+
+  // the last change of the columns, see `detail::Generation`
+  detail::Generation gen_;
+
+  std::vector<Column> columns_;
+  Config config_;
+
+  bool cached(const std::vector<size_t>& widths,
+              const std::string& vertical) const
+  {
+    return strGen_ == generation() && widths == strWidths_ &&
+           vertical == strVertical_;
+  }
+
+  // appends the row to `rowStr`, the columns cache their lines only if
+  // `cache` is set
+  void genStr(std::string& rowStr, const std::vector<size_t>& widths,
+              const std::string& vertical, const bool cache) const
+  {
+    if (columns_.empty()) return;
+
+    // the lines of every column, the ones that aren't cached are kept here
+    std::vector<const std::vector<std::string>*> lines(columns_.size());
+    std::vector<std::vector<std::string>> uncached;
+    uncached.reserve(cache ? 0 : columns_.size());
+
+    size_t maxLines = 0;
+    for (size_t j = 0; j < columns_.size(); ++j)
     {
-      padd.right = 0;
-      padd.left = 0;
+      const auto& column = columns_[j];
+
+      if (cache || column.cached(widths[j]))
+        lines[j] = &column.lines(widths[j]);
+      else
+      {
+        uncached.push_back(column.genLines(widths[j]));
+        lines[j] = &uncached.back();
+      }
+
+      maxLines = (std::max)(maxLines, lines[j]->size());
     }
 
-    width -= (padd.left + padd.right);
+    // the exact size (and a newline per line), the shorter columns are
+    // filled with empty lines
+    std::vector<std::string> empty(columns_.size());
+    size_t size = maxLines * ((columns_.size() + 1) * vertical.size() + 1);
 
-    if (delimiterDw >= width)
+    for (size_t j = 0; j < columns_.size(); ++j)
     {
-      delimiter = "";
-      delimiterDw = 0;
+      for (const auto& line : *lines[j])
+        size += line.size();
+
+      if (lines[j]->size() >= maxLines) continue;
+
+      empty[j] = columns_[j].genEmptyLine(widths[j]);
+      size += (maxLines - lines[j]->size()) * empty[j].size();
     }
 
-    // split the content into words
-    const auto words = split(content_);
+    rowStr.reserve(rowStr.size() + size);
 
-    // wrap the words into lines
-    const std::vector<detail::Str> lines =
-        wrap(words, width, delimiter, delimiterDw);
+    for (size_t i = 0; i < maxLines; ++i)
+    {
+      if (i > 0) rowStr.push_back('\n');
+      rowStr.append(vertical);
 
-    // format the lines handling padding, alignment and the base styles
-    return format(lines, padd);
+      for (size_t j = 0; j < columns_.size(); ++j)
+      {
+        if (lines[j]->size() > i)
+          rowStr.append((*lines[j])[i]);
+        else
+          rowStr.append(empty[j]);
+
+        rowStr.append(vertical);
+      }
+    }
   }
-  static void handleColor(std::string& styles, detail::ColorType colortype,
-                          bool back)
+};
+// clang-format off
+}
+
+namespace tabular {
+// clang-format off
+// a column to sort the rows by, see `Table::sort()`. the cells are compared
+// by their content without the escape sequences, either as text byte by
+// byte or as numbers. the cells that aren't numbers, or that the rows don't
+// have, go after the others in both orders
+class SortKey {
+public:
+  enum class Kind { Lexical, Numeric };
+
+  SortKey() = default;
+
+  static SortKey Lexical(const size_t column)
   {
-    if (colortype.isColor())
+    return SortKey(Kind::Lexical, column);
+  }
+  static SortKey Numeric(const size_t column)
+  {
+    return SortKey(Kind::Numeric, column);
+  }
+
+  SortKey& descending(const bool descending = true)
+  {
+    descending_ = descending;
+    return *this;
+  }
+
+  Kind kind() const { return kind_; }
+  size_t column() const { return column_; }
+  bool descending() const { return descending_; }
+
+private:
+  Kind kind_ = Kind::Lexical;
+  size_t column_ = 0;
+  bool descending_ = false;
+
+  SortKey(const Kind kind, const size_t column)
+    : kind_(kind), column_(column)
+  {
+  }
+};
+// clang-format on
+
+namespace detail {
+// the number in `str` (surrounded by spaces or not), or NaN if it isn't one
+inline double parseNumber(const std::string& str)
+{
+  const char* begin = str.c_str();
+  char* end = nullptr;
+
+  const double number = std::strtod(begin, &end);
+  if (end == begin) return std::numeric_limits<double>::quiet_NaN();
+
+  while (*end != '\0' && string_utils::isSpace(*end))
+    ++end;
+
+  return *end == '\0' ? number : std::numeric_limits<double>::quiet_NaN();
+}
+
+// sorts `indices` (of `rows`) by `keys`, the equal rows keep their order.
+// the key of every cell is extracted once, then the rows are sorted in
+// parts that are merged two by two, the parts and the merges are spread
+// over the executor or the threads
+inline void sortRows(const std::vector<Row>& rows, std::vector<size_t>& indices,
+                     const std::vector<SortKey>& keys, const Executor* executor,
+                     const size_t threads)
+{
+  const size_t size = indices.size();
+  if (size < 2 || keys.empty()) return;
+
+  const size_t tasks = (size + ROWS_PER_TASK - 1) / ROWS_PER_TASK;
+  const bool parallel = (executor != nullptr || threads > 1) && tasks > 1;
+
+  auto run = [&](const size_t count, const std::function<void(size_t)>& task) {
+    if (parallel) parallelFor(executor, threads, count, task);
+    else for (size_t i = 0; i < count; ++i) task(i);
+  };
+
+  // the keys of the rows at every position of `indices`, a single kind
+  // per sort key. a missing cell is an empty text, or not a number
+  std::vector<std::vector<std::string>> texts(keys.size());
+  std::vector<std::vector<double>> numbers(keys.size());
+
+  for (size_t k = 0; k < keys.size(); ++k)
+  {
+    if (keys[k].kind() == SortKey::Kind::Numeric)
+      numbers[k].assign(size, std::numeric_limits<double>::quiet_NaN());
+    else
+      texts[k].resize(size);
+  }
+
+  run(tasks, [&](const size_t task) {
+    const size_t first = task * ROWS_PER_TASK;
+    const size_t last = (std::min)(first + ROWS_PER_TASK, size);
+
+    for (size_t p = first; p < last; ++p)
     {
-      Color c = colortype.color();
-      styles += std::to_string(static_cast<uint8_t>(c) + (back ? 10 : 0)) + ';';
+      const auto& columns = rows[indices[p]].columns();
+      for (size_t k = 0; k < keys.size(); ++k)
+      {
+        const size_t column = keys[k].column();
+        if (column >= columns.size()) continue;
+
+        std::string text = string_utils::stripEscapes(columns[column].content());
+        if (keys[k].kind() == SortKey::Kind::Numeric)
+          numbers[k][p] = parseNumber(text);
+        else
+          texts[k][p] = std::move(text);
+      }
     }
+  });
 
-    else if (colortype.isRgb())
+  // the non-numbers go last whatever the order
+  auto less = [&](const size_t a, const size_t b) {
+    for (size_t k = 0; k < keys.size(); ++k)
     {
-      Rgb rgb = colortype.rgb();
-      styles += back ? "48;2;" : "38;2;";
-      styles += std::to_string(rgb.r) + ';';
-      styles += std::to_string(rgb.g) + ';';
-      styles += std::to_string(rgb.b) + ';';
+      const bool descending = keys[k].descending();
+      if (keys[k].kind() == SortKey::Kind::Numeric)
+      {
+        const double x = numbers[k][a], y = numbers[k][b];
+        if (std::isnan(x) || std::isnan(y))
+        {
+          if (std::isnan(x) && std::isnan(y)) continue;
+          return std::isnan(y);
+        }
+
+        if (x != y) return descending ? y < x : x < y;
+      }
+
+      else
+      {
+        const int order = texts[k][a].compare(texts[k][b]);
+        if (order != 0) return descending ? order > 0 : order < 0;
+      }
+    }
+
+    return false;
+  };
+
+  std::vector<size_t> positions(size);
+  std::iota(positions.begin(), positions.end(), size_t(0));
+
+  if (!parallel)
+    std::stable_sort(positions.begin(), positions.end(), less);
+
+  else
+  {
+    run(tasks, [&](const size_t task) {
+      const size_t first = task * ROWS_PER_TASK;
+      const size_t last = (std::min)(first + ROWS_PER_TASK, size);
+      std::stable_sort(positions.begin() + first, positions.begin() + last, less);
+    });
+
+    // the sorted parts are merged two by two until there is one left, the
+    // left part goes first on equal rows
+    std::vector<size_t> merged(size);
+    for (size_t width = ROWS_PER_TASK; width < size; width *= 2)
+    {
+      const size_t pairs = (size + 2 * width - 1) / (2 * width);
+      run(pairs, [&](const size_t pair) {
+        const size_t first = pair * 2 * width;
+        const size_t middle = (std::min)(first + width, size);
+        const size_t last = (std::min)(first + 2 * width, size);
+
+        std::merge(positions.begin() + first, positions.begin() + middle,
+                   positions.begin() + middle, positions.begin() + last,
+                   merged.begin() + first, less);
+      });
+
+      positions.swap(merged);
     }
   }
-  static void handleAttrs(std::string& styles, Attr attr)
+
+  std::vector<size_t> sorted(size);
+  for (size_t p = 0; p < size; ++p)
+    sorted[p] = indices[positions[p]];
+
+  indices = std::move(sorted);
+}
+} // namespace detail
+} // namespace tabular
+
+namespace tabular {
+
+namespace detail {
+// the widths the table assigns to the columns of each row, they are kept
+// apart from the rows so laying the table out never touches the cells
+struct Layout {
+  std::vector<std::vector<size_t>> widths;
+
+  // the generations of the rows, and the lengths of the header and every
+  // row's part of the output (the row and its bottom border), so a changed
+  // row can be spliced into the output
+  std::vector<uint64_t> generations;
+  std::vector<size_t> lengths;
+  size_t header = 0;
+
+  // the auto-fit widths the rows were laid out with
+  std::vector<std::vector<size_t>> fits;
+};
+
+// the widths of the columns sharing `available`, the ones with a non-zero
+// width in `widths` keep it. the others get the width that fits their
+// content (`maximum`) if they all fit, or else at least their longest word
+// (`minimum`) and the rest of the space relative to what they miss to fit,
+// so the table wraps as little as it can
+inline std::vector<size_t> fitWidths(std::vector<size_t> widths,
+                                     const std::vector<size_t>& minimum,
+                                     const std::vector<size_t>& maximum,
+                                     size_t available)
+{
+  const size_t columns = widths.size();
+  std::vector<bool> fixed(columns, false);
+
+  size_t fixedWidth = 0, unspecified = 0;
+  for (size_t i = 0; i < columns; ++i)
   {
-    auto hasAttr = [](Attr attr, Attr flag) -> bool {
-      return static_cast<uint16_t>(attr) & static_cast<uint16_t>(flag);
-    };
+    fixed[i] = widths[i] != 0;
+    if (fixed[i]) fixedWidth += widths[i];
+    else unspecified++;
+  }
 
-    if (hasAttr(attr, Attr::Bold)) styles += "1;";
-    if (hasAttr(attr, Attr::Dim)) styles += "2;";
-    if (hasAttr(attr, Attr::Italic)) styles += "3;";
-    if (hasAttr(attr, Attr::Underline)) styles += "4;";
-    if (hasAttr(attr, Attr::Dunderline)) styles += "21;";
-    if (hasAttr(attr, Attr::Blink)) styles += "5;";
-    if (hasAttr(attr, Attr::Flink)) styles += "6;";
-    if (hasAttr(attr, Attr::Reverse)) styles += "7;";
-    if (hasAttr(attr, Attr::Concealed)) styles += "8;";
-    if (hasAttr(attr, Attr::Crossed)) styles += "9;";
+  // the fixed widths must leave enough space for the others, or fill the
+  // whole space if there are no others
+  if (unspecified == 0 ? fixedWidth != available
+                       : fixedWidth + unspecified * MIN_COLUMN_WIDTH > available)
+  {
+    fixed.assign(columns, false);
+    fixedWidth = 0;
+    unspecified = columns;
   }
 
-  std::string resolveStyles() const
+  if (unspecified == 0) return widths;
+  available -= fixedWidth;
+
+  size_t minTotal = 0, maxTotal = 0;
+  for (size_t i = 0; i < columns; ++i)
   {
-    std::string styles = "\x1b[";
+    if (fixed[i]) continue;
+    minTotal += minimum[i];
+    maxTotal += maximum[i];
+  }
 
-    if (style().hasAttrs()) handleAttrs(styles, style().attrs());
+  size_t used = 0;
 
-    if (style().hasFg()) handleColor(styles, style().fg(), false);
+  // nothing wraps
+  if (maxTotal <= available)
+  {
+    for (size_t i = 0; i < columns; ++i)
+    {
+      if (fixed[i]) continue;
+      widths[i] = maximum[i];
+      used += widths[i];
+    }
+  }
 
-    if (style().hasBg()) handleColor(styles, style().bg(), true);
+  // no word is broken, the columns that miss more get more
+  else if (minTotal <= available)
+  {
+    const size_t space = available - minTotal;
+    const size_t missing = maxTotal - minTotal;
 
-    if (styles == "\x1b[") return ""; // empty
+    for (size_t i = 0; i < columns; ++i)
+    {
+      if (fixed[i]) continue;
+      widths[i] = minimum[i] + (maximum[i] - minimum[i]) * space / missing;
+      used += widths[i];
+    }
 
-    if (styles.back() == ';') styles.back() = 'm';
-    return styles;
+    // the rounding leftovers
+    for (size_t i = 0; used < available; i = (i + 1) % columns)
+    {
+      if (fixed[i] || widths[i] >= maximum[i]) continue;
+      widths[i]++;
+      used++;
+    }
   }
-  std::string resolveBase() const
+
+  // the words are broken anyway, shrink the columns relative to each other
+  else
   {
-    std::string base = "\x1b[";
-    handleColor(base, style().base(), true);
+    for (size_t i = 0; i < columns; ++i)
+    {
+      if (fixed[i]) continue;
 
-    if (base == "\x1b[") return ""; // empty
+      const size_t w = minimum[i] * available / minTotal;
+      widths[i] = (std::max)(w, static_cast<size_t>(MIN_COLUMN_WIDTH));
+      used += widths[i];
+    }
 
-    if (base.back() == ';') base.back() = 'm';
-    return base;
+    while (used > available)
+    {
+      size_t widest = columns;
+      for (size_t i = 0; i < columns; ++i)
+      {
+        if (fixed[i]) continue;
+        if (widest == columns || widths[i] > widths[widest]) widest = i;
+      }
+
+      widths[widest]--;
+      used--;
+    }
   }
 
-  std::vector<std::string> split(const std::string& str) const
+  // hand out the rest
+  for (size_t i = 0; used < available; i = (i + 1) % columns)
   {
-    using namespace string_utils;
+    if (fixed[i]) continue;
+    widths[i]++;
+    used++;
+  }
 
-    const size_t len = str.length();
+  return widths;
+}
+}
 
-    std::vector<std::string> words;
-    words.reserve((len / WORD_LENGTH_AVERAGE) + 1); // average
+// clang-format off
+class Table {
+public:
+  class Config {
+  public:
+    void width(const size_t width)
+    {
+      detail::assign(width_, width, gen_);
+    }
 
-    std::string buffer;
-    buffer.reserve(WORD_LENGTH_AVERAGE);
+    size_t width() const { return width_; }
 
-    size_t i = 0;
-    while (i < len)
+    // lays every row out with the same widths per number of columns, that
+    // fit the content of all the rows (see `detail::fitWidths()`), instead
+    // of sharing the table's width evenly between a row's columns
+    void autoFit(const bool fit)
     {
-      if (str[i] == '\x1b')
-      {
-        if (!buffer.empty()) words.emplace_back(std::move(buffer));
-        buffer.clear();
+      detail::assign(autoFit_, fit, gen_);
+    }
+    bool autoFit() const { return autoFit_; }
 
-        while (i < len && isAscii(str[i]) && !isAlpha(str[i]))
-          buffer += str[i++];
+    // the width of the columns at the same index in every row, resolved
+    // once for every number of columns instead of for every row. it takes
+    // over the columns' own widths and the auto-fit
+    void columns(std::vector<ColumnWidth> columns)
+    {
+      detail::assign(columns_, std::move(columns), gen_);
+    }
+    const std::vector<ColumnWidth>& columns() const { return columns_; }
+
+    // renders the rows on `count` threads, or on `executor` running up to
+    // `concurrency` tasks at once (as many as the hardware threads if 0), the
+    // output doesn't change, only the time it takes. a single thread by
+    // default
+    void threads(const size_t count) { threads_ = count; }
+    void executor(Executor executor, const size_t concurrency = 0)
+    {
+      executor_ = executor ? std::make_shared<Executor>(std::move(executor))
+                           : nullptr;
+      concurrency_ = concurrency > 0 ? concurrency
+                                     : std::thread::hardware_concurrency();
+    }
 
-        if (i < len) buffer += str[i++];
-        words.emplace_back(std::move(buffer));
-        buffer.clear();
-        continue;
-      }
+    size_t threads() const { return threads_; }
+    bool parallel() const { return threads_ > 1 || executor_ != nullptr; }
 
-      if (isSpace(str[i]))
-      {
-        if (!buffer.empty()) words.emplace_back(std::move(buffer));
-        buffer.clear();
+    void reset()
+    {
+      width(DEFAULT_WIDTH);
+      autoFit(false);
+      columns({});
+      threads_ = 1;
+      executor_ = nullptr;
+      concurrency_ = 0;
+    }
 
-        words.emplace_back(1, str[i++]);
-        continue;
-      }
+  private:
+    friend class Table;
 
-      buffer += str[i++];
-    }
+    // the last change, see `detail::Generation`
+    detail::Generation gen_;
 
-    if (!buffer.empty()) words.emplace_back(std::move(buffer));
-    return words;
-  }
-  std::vector<detail::Str> wrap(const std::vector<std::string>& words,
-                                const size_t width,
-                                const std::string& delimiter,
-                                const size_t delimiterDw) const
-  {
-    using namespace string_utils;
+    size_t width_ = DEFAULT_WIDTH;
+    bool autoFit_ = false;
+    std::vector<ColumnWidth> columns_;
 
-    const std::string styles = resolveStyles();
-    const bool skipBlanks = config_.skipEmptyLineIndent();
+    // how the rows are rendered, they don't change the output
+    size_t threads_ = 1;
+    std::shared_ptr<Executor> executor_;
+    size_t concurrency_ = 0;
+  };
 
-    std::vector<detail::Str> lines;
-    lines.reserve(content_.length() / width + 1);
+public:
+  Table() = default;
 
-    std::string buffer;
-    size_t bufferDw = 0; // the display width
+  explicit Table(std::vector<Row> rows, Border border = {})
+    : rows_(std::move(rows)), border_(std::move(border))
+  {
+    gen_.bump();
+  }
 
-    buffer.reserve(width);
-    if (!styles.empty()) buffer += styles;
+  Table(const Table&) = default;
+  Table(Table&&) noexcept = default;
+  Table& operator=(const Table&) = default;
+  Table& operator=(Table&&) noexcept = default;
 
-    // in case the line contains active escape sequences, and they were NOT
-    // reset (with '\x1b[0m'), we need to register them, reset them
-    // at the end of the line, and restore them in the next line.
-    std::string activeEscs;
+  void rows(std::vector<Row> rows)
+  {
+    rows_ = std::move(rows);
+    gen_.bump();
+  }
+  void border(Border border)
+  {
+    border_ = std::move(border);
+    gen_.bump();
+  }
 
-    // helper lambdas to avoid repeating code
-    auto appendResetIfNeeded = [&]() {
-      if (!(activeEscs.empty() && styles.empty()) && !endsWith(buffer, RESET_ESC))
-        buffer += RESET_ESC;
-    };
-    auto startNewLine = [&]() {
-      appendResetIfNeeded();
-      lines.push_back({buffer, bufferDw});
+  Table& addRow(Row row)
+  {
+    rows_.emplace_back(std::move(row));
+    gen_.bump();
+    return *this;
+  }
+  Table& addRow(std::vector<std::string> row)
+  {
+    rows_.emplace_back(std::move(row));
+    gen_.bump();
+    return *this;
+  }
 
-      buffer.clear();
-      bufferDw = 0;
+  Config& config() { return config_; }
+  const Config& config() const { return config_; }
 
-      if (!styles.empty()) buffer += styles;
-      if (!activeEscs.empty()) buffer += activeEscs;
-    };
+  // the border and the rows track their own changes, handing them out isn't
+  // a change
+  Border& border() { return border_; }
+  const Border& border() const { return border_; }
 
-    for (size_t i = 0; i < words.size(); ++i)
-    {
-      std::string word = words[i];
+  std::vector<Row>& rows() { return rows_; }
+  const std::vector<Row>& rows() const { return rows_; }
 
-      // SKIP empty strings
-      if (word.empty()) continue;
+  // only the rows that changed are rendered again
+  Row& row(int index)
+  {
+    return rows_.at(index);
+  }
+  const Row& row(int index) const { return rows_.at(index); }
 
-      // SKIP spaces at the start of a new line
-      if (skipBlanks && buffer.empty() && word == " ") continue;
+  Row& operator[](int index)
+  {
+    return rows_.at(index);
+  }
+  const Row& operator[](int index) const
+  {
+    return rows_.at(index);
+  }
 
-      // HANDLE new lines
-      if (word == "\n")
-      {
-        startNewLine();
-        continue;
-      }
+  // sorts the rows by the cells of `keys`, the first key first then the
+  // next one for the rows it finds equal, ... the equal rows keep their
+  // order and the rows before `first` (e.g. a header) stay in place. the
+  // keys are extracted once, the rows are sorted concurrently in parallel
+  // mode and moved to their places, their cached output goes with them
+  Table& sort(const std::vector<SortKey>& keys, const size_t first = 0)
+  {
+    if (first >= rows_.size()) return *this;
 
-      // IGNORE other space characters
-      if (word.length() == 1 && isSpace(word[0]) && word != " ") continue;
+    std::vector<size_t> indices(rows_.size() - first);
+    std::iota(indices.begin(), indices.end(), first);
 
-      // HANDLE escape sequences
-      if (word[0] == '\x1b')
-      {
-        if (word.back() != 'm') continue;
+    sortRows(indices, keys);
 
-        const auto* nextWord = i + 1 < words.size() ? &words[i + 1] : nullptr;
-        if (word == "\x1b[0m")
-        {
-          activeEscs.clear();
-          buffer += word;
+    std::vector<Row> rows;
+    rows.reserve(rows_.size());
 
-          if (nextWord && dw(*nextWord) + bufferDw <= width) buffer += styles;
+    for (size_t i = 0; i < first; ++i)
+      rows.push_back(std::move(rows_[i]));
+    for (const size_t i : indices)
+      rows.push_back(std::move(rows_[i]));
 
-          continue;
-        }
+    rows_ = std::move(rows);
+    gen_.bump();
+    return *this;
+  }
 
-        activeEscs += word;
+  void clr()
+  {
+    rows_.clear();
+    config_.reset();
+    border_.reset();
+    str_.clear();
+    layout_ = detail::Layout();
+    strGen_ = generation();
+  }
 
-        if (nextWord && dw(*nextWord) + bufferDw <= width) buffer += word;
+  const std::string& str() const
+  {
+    // the rows that changed are spliced into the output, unless the whole
+    // table changed
+    if (!current() || !update())
+    {
+      str_ = genStr();
+      strGen_ = generation();
+    }
 
-        continue;
-      }
+    return str_;
+  }
 
-      // word display width
-      size_t wordDw = dw(word);
+  // the exact size of `str()` in bytes, e.g. to size a buffer up front.
+  // the rows are rendered (and cached) to measure them, but the table's
+  // string isn't built
+  size_t size() const
+  {
+    if (current() && update()) return str_.size();
+    if (rows_.empty()) return 0;
 
-      // the word fits in the line
-      if (wordDw + bufferDw <= width)
-      {
-        buffer += word;
-        bufferDw += wordDw;
-        continue;
-      }
+    detail::Layout layout = genLayout();
+    return getBorderHeader(layout.widths.front()).size() + 1 + measure(layout) +
+           getBorderFooter(layout.widths.back()).size();
+  }
 
-      // the word fits in the next line
-      if (wordDw <= width)
-      {
-        startNewLine();
+  // writes the table to `sink` piece by piece, a header, a row with its
+  // bottom border, ... then the footer, instead of building it as a whole.
+  // `sink` is called as `sink(const char* data, size_t length)`, and the
+  // written output is the same as `str()`.
+  // NOTE: only one row is held in memory at a time, nothing is cached
+  template <typename Sink> void render(Sink&& sink) const
+  {
+    // the output is already there, bring it up to date
+    if (current())
+    {
+      const std::string& str = this->str();
+      if (!str.empty()) sink(str.data(), str.size());
+      return;
+    }
 
-        // add the next word and avoid spaces
-        if (word != " ")
-        {
-          buffer += word;
-          bufferDw += wordDw;
-        }
+    if (rows_.empty()) return;
 
-        continue;
-      }
+    checkWidth();
+    if (autoFit()) refreshFits();
 
-      /*
-       * if we reach here that means the word's display width
-       * exceeds the line width
-       */
+    if (config_.parallel()) return renderParallel(sink);
+    renderRows(sink, 0, rows_.size(), identity, false);
+  }
 
-      // no free space, append the current line and process the others
-      if (bufferDw >= width - delimiterDw) startNewLine();
+  // writes the rows [first, last) the same way, as a table of their own with
+  // a header above the first one and a footer below the last one, e.g. for
+  // a pager. the columns keep their widths in the whole table so the pages
+  // line up, and only the rows of the window are rendered.
+  // NOTE: the auto-fit widths come from all the rows, they are computed
+  // again only if a row changed, but every row is checked for changes
+  template <typename Sink>
+  void render(Sink&& sink, const size_t first, size_t last) const
+  {
+    last = (std::min)(last, rows_.size());
+    if (first >= last) return;
 
-      while (wordDw > width)
-      {
-        size_t limit = width - delimiterDw - bufferDw;
+    for (size_t i = first; i < last; ++i)
+      checkWidth(i);
 
-        std::string firstPart;
-        size_t firstPartDw = 0;
-        firstPart.reserve(limit);
+    if (autoFit()) refreshFits();
+    renderRows(sink, first, last, identity, false);
+  }
 
-        size_t pos = 0;
-        while (firstPartDw < limit)
-        {
-          std::string utf8char = readUtf8Char(word, pos);
-          size_t utf8charDw = dw(utf8char);
+  // the string form of the rows [first, last), see `render()`
+  std::string str(const size_t first, const size_t last) const
+  {
+    std::string str;
+    render([&str](const char* data, const size_t length) { str.append(data, length); },
+           first, last);
 
-          // if it will exceed the limit don't append
-          if (utf8charDw + firstPartDw > limit) break;
+    return str;
+  }
 
-          // otherwise append this part
-          firstPart += utf8char;
-          firstPartDw += utf8charDw;
+private:
+  // the writer and the virtual table lay their rows out and draw their
+  // borders the same way, the views render the table's rows in their order
+  friend class Writer;
+  friend class VirtualTable;
+  friend class TableView;
 
-          if (utf8char.empty()) pos++;
-          else pos += utf8char.length();
-        }
+  // cache
+  mutable std::string str_;
+  mutable uint64_t strGen_ = 0;
 
-        // prepare the next word
-        word = word.substr(pos);
-        wordDw -= firstPartDw;
+  // the columns widths of the last render
+  mutable detail::Layout layout_;
 
-        // add the delimiter
-        firstPart += delimiter;
-        firstPartDw += delimiterDw;
+  // the auto-fit widths for every number of columns, and the state of the
+  // rows they were computed from, see `refreshFits()`
+  mutable std::vector<std::vector<size_t>> fits_;
+  mutable uint64_t fitsGen_ = 0;
+  mutable std::vector<std::pair<uint64_t, size_t>> fitsRows_;
 
-        // add the stuff into the buffer
-        buffer += firstPart;
-        bufferDw += firstPartDw;
+  // the separators for every pair of rows layouts, see `middle()`
+  mutable std::map<std::vector<size_t>,
+                   std::map<std::vector<size_t>, std::string>> middles_;
+  mutable size_t middlesCount_ = 0;
+  mutable uint64_t middlesGen_ = 0;
 
-        // append a new line
-        startNewLine();
-      }
+  // the `Config::columns()` widths for every number of columns, and the
+  // configuration they were resolved with
+  mutable std::vector<std::vector<size_t>> resolved_;
+  mutable uint64_t resolvedGen_ = 0;
 
-      buffer += word;
-      bufferDw += wordDw;
-    }
+  // the last change of the rows, see `detail::Generation`
+  detail::Generation gen_;
 
-    if (!buffer.empty())
-    {
-      appendResetIfNeeded();
-      lines.push_back({buffer, bufferDw});
-    }
+  std::vector<Row> rows_;
+  Config config_;
+  Border border_;
 
-    return lines;
+  // changes whenever the table changes as a whole, the rows changes are
+  // tracked by the rows themselves
+  uint64_t generation() const
+  {
+    const uint64_t generation = (std::max)(gen_, config_.gen_);
+    return (std::max)(generation, border_.generation());
   }
-  std::vector<std::string> format(const std::vector<detail::Str>& lines,
-                                  const Padd padd) const
+
+  // the columns widths come from their content
+  bool autoFit() const
   {
-    using namespace string_utils;
+    return config_.autoFit() && config_.columns().empty();
+  }
 
-    const size_t width = config().width();
-    const std::string base = resolveBase();
-    const Align align = config().align();
+  // the cached output only needs the changed rows to be rendered again,
+  // rows added or removed through `rows()` change the whole table
+  bool current() const
+  {
+    return strGen_ == generation() && layout_.generations.size() == rows_.size();
+  }
 
-    std::vector<std::string> formatted;
-    formatted.reserve(lines.size() + padd.top + padd.bottom);
+  std::string genStr() const
+  {
+    if (rows_.empty())
+    {
+      layout_ = detail::Layout();
+      return "";
+    }
 
-    const bool styled = !base.empty();
-    const std::string empty = genEmptyLine();
-    formatted.insert(formatted.end(), padd.top, empty);
+    // lay the columns out, the cells keep their own configuration
+    detail::Layout layout = genLayout();
 
-    // temporary buffer
-    std::string buffer;
-    buffer.reserve(width);
+    const std::string header = getBorderHeader(layout.widths.front());
+    const std::string footer = getBorderFooter(layout.widths.back());
 
-    for (const auto& line : lines)
-    {
-      // append the base styles
-      if (styled) buffer += base;
+    // the rows are rendered to measure them, then copied into a string
+    // allocated once
+    const size_t size = header.size() + 1 + measure(layout) + footer.size();
 
-      // calculate the total line width
-      const size_t lineWidth = line.dw + padd.left + padd.right;
-      const size_t freeSpace = (width > lineWidth) ? width - lineWidth : 0;
+    std::string tableStr;
+    tableStr.reserve(size);
 
-      size_t leftSpace = 0, rightSpace = 0;
-      switch (align)
-      {
-      case Align::Left:
-        leftSpace = 0;
-        rightSpace = freeSpace;
-        break;
-      case Align::Center: {
-        leftSpace = freeSpace / 2;
-        rightSpace = freeSpace - leftSpace;
-        break;
-      }
-      case Align::Right:
-        leftSpace = freeSpace;
-        rightSpace = 0;
-        break;
-      }
+    tableStr += header;
+    tableStr += '\n';
+    layout.header = tableStr.size();
 
-      buffer.append(leftSpace + padd.left, ' ');
-      buffer += line.str;
+    for (size_t i = 0; i < rows_.size(); ++i)
+      appendRow(tableStr, layout, i, 0, true);
 
-      if (endsWith(line.str, RESET_ESC)) buffer += base;
+    tableStr += footer;
 
-      buffer.append(rightSpace + padd.right, ' ');
+    layout_ = std::move(layout);
+    return tableStr;
+  }
 
-      // reset the base styles
-      if (styled) buffer += RESET_ESC;
+  // renders the rows (they cache their output) to record their generations
+  // and the lengths of their parts of the output, and returns the sum of
+  // the lengths. the rows are rendered concurrently in parallel mode
+  size_t measure(detail::Layout& layout) const
+  {
+    const size_t size = rows_.size();
+    layout.generations.resize(size);
+    layout.lengths.resize(size);
 
-      formatted.emplace_back(std::move(buffer));
-      buffer.clear();
-    }
+    auto measureRows = [&](const size_t first, const size_t last) {
+      for (size_t i = first; i < last; ++i)
+      {
+        const Row& row = rows_[i];
+        const auto& widths = layout.widths[i];
 
-    formatted.insert(formatted.end(), padd.bottom, empty);
-    return formatted;
-  }
-};
+        size_t length = row.str(widths, vertical(row)).size() + 1;
+        if (i + 1 < size && row.config().hasBottom())
+          length += middle(widths, layout.widths[i + 1]).size() + 1;
 
-inline Attr operator|(Attr lhs, Attr rhs) noexcept
-{
-  return static_cast<Attr>(static_cast<uint16_t>(lhs) |
-                                static_cast<uint16_t>(rhs));
-}
+        layout.generations[i] = row.generation();
+        layout.lengths[i] = length;
+      }
+    };
 
-inline Attr& operator|=(Attr& lhs, const Attr rhs) noexcept
-{
-  lhs = lhs | rhs;
-  return lhs;
-}
+    const size_t tasks = (size + ROWS_PER_TASK - 1) / ROWS_PER_TASK;
+    if (!config_.parallel() || tasks <= 1)
+      measureRows(0, size);
 
-class Border {
-public:
-  class Part {
-  public:
-    Part(const uint32_t glyph)
-      : glyph_(glyph), dirty_(true)
+    else
     {
+      prepare(layout, 0, size, 0);
+      detail::parallelFor(config_.executor_.get(), config_.threads_, tasks,
+                          [&](const size_t task) {
+        const size_t first = task * ROWS_PER_TASK;
+        measureRows(first, (std::min)(first + ROWS_PER_TASK, size));
+      });
     }
 
-    Part& glyph(const uint32_t glyph)
-    {
-      glyph_ = glyph;
-      dirty_ = true;
-      return *this;
-    }
+    size_t length = 0;
+    for (const size_t l : layout.lengths)
+      length += l;
 
-    Part& fg(const Color color)
-    {
-      fg_ = static_cast<uint32_t>(color);
-      dirty_ = true;
-      return *this;
-    }
-    Part& fg(const Rgb rgb)
-    {
-      fg_ = rgb.toHex() | (1u << 24);
-      dirty_ = true;
-      return *this;
-    }
+    return length;
+  }
 
-    Part& bg(const Color color)
-    {
-      bg_ = static_cast<uint32_t>(color);
-      dirty_ = true;
-      return *this;
-    }
-    Part& bg(const Rgb rgb)
+  // caches the shared border parts and the separators of the rows
+  // [first, last) before the threads use them
+  void prepare(const detail::Layout& layout, const size_t first,
+               const size_t last, const size_t offset) const
+  {
+    warmBorder();
+    for (size_t i = first; i < last; ++i)
     {
-      bg_ = rgb.toHex() | (1u << 24);
-      dirty_ = true;
-      return *this;
+      if (i + 1 < rows_.size() && rows_[i].config().hasBottom())
+        middle(layout.widths[i - offset], layout.widths[i + 1 - offset]);
     }
+  }
 
-    uint32_t fg() const
-    {
-      return fg_;
-    }
-    uint32_t bg() const
-    {
-      return bg_;
-    }
-    uint32_t glyph() const
-    {
-      return glyph_;
-    }
+  // appends the rows [first, last) with their bottom borders without
+  // caching them, the widths of row `i` are `layout.widths[i - offset]`.
+  // the rows are rendered concurrently in parallel mode, the output stays
+  // the same
+  void genRows(std::string& out, const detail::Layout& layout,
+               const size_t first, const size_t last,
+               const size_t offset) const
+  {
+    const size_t count = last - first;
+    const size_t tasks = (count + ROWS_PER_TASK - 1) / ROWS_PER_TASK;
 
-    Part& clrFg()
-    {
-      fg_ = 0;
-      dirty_ = true;
-      return *this;
-    }
-    Part& clrBg()
+    if (!config_.parallel() || tasks <= 1)
     {
-      bg_ = 0;
-      dirty_ = true;
-      return *this;
+      for (size_t i = first; i < last; ++i)
+        appendRow(out, layout, i, offset, false);
+      return;
     }
-    Part& clr()
+
+    prepare(layout, first, last, offset);
+
+    std::vector<std::string> parts(tasks);
+    detail::parallelFor(config_.executor_.get(), config_.threads_, tasks,
+                        [&](const size_t task) {
+      const size_t begin = first + task * ROWS_PER_TASK;
+      const size_t end = (std::min)(begin + ROWS_PER_TASK, last);
+
+      for (size_t i = begin; i < end; ++i)
+        appendRow(parts[task], layout, i, offset, false);
+    });
+
+    size_t size = out.size();
+    for (const auto& part : parts)
+      size += part.size();
+
+    out.reserve(size);
+    for (auto& part : parts)
     {
-      fg_ = 0;
-      bg_ = 0;
-      dirty_ = true;
-      return *this;
+      out += part;
+      std::string().swap(part);
     }
+  }
 
-    explicit operator const std::string&() const { return str(); }
-    const std::string& str() const
-    {
-      if (dirty_)
-      {
-        str_ = genStr();
-        dirty_ = false;
-      }
+  // appends the row with its bottom border, and returns the appended length
+  size_t appendRow(std::string& out, const detail::Layout& layout,
+                   const size_t index, const size_t offset,
+                   const bool cache) const
+  {
+    const size_t length = out.size();
+    const auto& row = rows_[index];
+    const auto& widths = layout.widths[index - offset];
 
-      return str_;
+    if (cache) out += row.str(widths, vertical(row));
+    else row.write(out, widths, vertical(row));
+    out += '\n';
+
+    if (index + 1 < rows_.size() && row.config().hasBottom())
+    {
+      out += middle(widths, layout.widths[index + 1 - offset]);
+      out += '\n';
     }
 
-  private:
-    uint32_t glyph_ = 0; // Unicode code point
-    uint32_t fg_ = 0; // fg color
-    uint32_t bg_ = 0; // bg color
+    return out.size() - length;
+  }
 
-    // cache
-    mutable bool dirty_ = false;
-    mutable std::string str_;
+  static size_t identity(const size_t index) { return index; }
 
-    std::string genStr() const
-    {
-      using namespace detail;
-      std::string buffer;
+  // sorts the indices of some rows, see `sort()`
+  void sortRows(std::vector<size_t>& indices,
+                const std::vector<SortKey>& keys) const
+  {
+    detail::sortRows(rows_, indices, keys, config_.executor_.get(),
+                     config_.threads_);
+  }
+
+  // streams the rows `index(first)` ... `index(last - 1)` one by one, they
+  // cache their output only if `cache`
+  template <typename Sink, typename Index>
+  void renderRows(Sink&& sink, const size_t first, const size_t last,
+                  Index index, const bool cache) const
+  {
+    std::string buffer;
+    std::vector<size_t> widths = genWidths(index(first));
 
-      ColorType fg = fg_;
-      ColorType bg = bg_;
+    buffer += getBorderHeader(widths);
+    buffer += '\n';
 
-      if (fg.isColor())
+    for (size_t i = first; i < last; ++i)
+    {
+      const auto& row = rows_[index(i)];
+      if (cache) buffer += row.str(widths, vertical(row));
+      else row.write(buffer, widths, vertical(row));
+      trimMiddles();
+
+      // the footer follows the last row
+      if (i + 1 >= last)
       {
-        buffer.append("\x1b[");
-        buffer.append(std::to_string(static_cast<uint8_t>(fg.color())));
-        buffer.push_back(';');
+        buffer += '\n';
+        buffer += getBorderFooter(widths);
       }
-      else if (fg.isRgb())
+
+      else
       {
-        Rgb rgb = fg.rgb();
-        buffer.append("\x1b[38;2;");
+        std::vector<size_t> nextWidths = genWidths(index(i + 1));
+        buffer += '\n';
 
-        buffer.append(std::to_string(rgb.r));
-        buffer.push_back(';');
-        buffer.append(std::to_string(rgb.g));
-        buffer.push_back(';');
-        buffer.append(std::to_string(rgb.b));
-        buffer.push_back(';');
-      }
+        if (row.config().hasBottom())
+        {
+          buffer += middle(widths, nextWidths);
+          buffer += '\n';
+        }
 
-      if (bg.isColor())
-      {
-        if (buffer.empty()) buffer.append("\x1b[");
-        buffer.append(std::to_string(static_cast<uint8_t>(bg.color()) + 10));
-        buffer.push_back(';');
-      }
-      else if (bg.isRgb())
-      {
-        Rgb rgb = bg.rgb();
-        if (buffer.empty()) buffer.append("\x1b[48;2;");
-        buffer.append(std::to_string(rgb.r));
-        buffer.push_back(';');
-        buffer.append(std::to_string(rgb.g));
-        buffer.push_back(';');
-        buffer.append(std::to_string(rgb.b));
-        buffer.push_back(';');
+        widths = std::move(nextWidths);
       }
 
-      const std::string glyph = glyphToStr();
-      buffer.append(glyph);
+      sink(buffer.data(), buffer.size());
+      buffer.clear();
+    }
+  }
 
-      if (buffer.length() - glyph.length() > 0)
-        buffer.append(RESET_ESC);
+  // streams the rows in batches rendered concurrently, nothing is cached
+  template <typename Sink> void renderParallel(Sink&& sink) const
+  {
+    // a few tasks per thread, the whole batch is held before it's written
+    const size_t threads = config_.executor_ ? config_.concurrency_ : config_.threads_;
+    const size_t batch = ROWS_PER_TASK * (std::max)(threads, size_t(1)) * 4;
 
-      return buffer;
-    }
-    std::string glyphToStr() const
+    std::string buffer;
+    detail::Layout layout;
+
+    for (size_t first = 0; first < rows_.size(); first += batch)
     {
-      std::string result;
+      const size_t last = (std::min)(first + batch, rows_.size());
+      trimMiddles();
 
-      if (glyph_ <= 0x7F)
-      {
-        result += static_cast<char>(glyph_);
-      }
+      // the widths of the batch, and of the next row for the last border
+      layout.widths.clear();
+      for (size_t i = first; i < last + 1 && i < rows_.size(); ++i)
+        layout.widths.push_back(genWidths(i));
 
-      else if (glyph_ <= 0x7FF)
+      if (first == 0)
       {
-        result += static_cast<char>(0xC0 | ((glyph_ >> 6) & 0x1F));
-        result += static_cast<char>(0x80 | (glyph_ & 0x3F));
+        buffer += getBorderHeader(layout.widths.front());
+        buffer += '\n';
       }
 
-      else if (glyph_ <= 0xFFFF)
-      {
-        result += static_cast<char>(0xE0 | ((glyph_ >> 12) & 0x0F));
-        result += static_cast<char>(0x80 | ((glyph_ >> 6) & 0x3F));
-        result += static_cast<char>(0x80 | (glyph_ & 0x3F));
-      }
+      genRows(buffer, layout, first, last, first);
 
-      else
-      {
-        result += static_cast<char>(0xF0 | ((glyph_ >> 18) & 0x07));
-        result += static_cast<char>(0x80 | ((glyph_ >> 12) & 0x3F));
-        result += static_cast<char>(0x80 | ((glyph_ >> 6) & 0x3F));
-        result += static_cast<char>(0x80 | (glyph_ & 0x3F));
-      }
+      if (last == rows_.size())
+        buffer += getBorderFooter(layout.widths.back());
 
-      return result;
+      sink(buffer.data(), buffer.size());
+      buffer.clear();
     }
-  };
+  }
 
-  Part& horizontal() { return horizontal_; }
-  Part& vertical() { return vertical_; }
-  Part& cornerTopLeft() { return cornerTopLeft_; }
-  Part& cornerTopRight() { return cornerTopRight_; }
-  Part& cornerBottomLeft() { return cornerBottomLeft_; }
-  Part& cornerBottomRight() { return cornerBottomRight_; }
-  Part& intersection() { return intersection_; }
-  Part& connectorLeft() { return connectorLeft_; }
-  Part& connectorRight() { return connectorRight_; }
-  Part& connectorTop() { return connectorTop_; }
-  Part& connectorBottom() { return connectorBottom_; }
+  // the separator between two rows laid out with `widths` and `nextWidths`,
+  // memoized since most rows share their layout
+  const std::string& middle(const std::vector<size_t>& widths,
+                            const std::vector<size_t>& nextWidths) const
+  {
+    const uint64_t generation = border_.generation();
+    if (middlesGen_ != generation)
+    {
+      middles_.clear();
+      middlesCount_ = 0;
+      middlesGen_ = generation;
+    }
 
-  const Part& horizontal() const { return horizontal_; }
-  const Part& vertical() const { return vertical_; }
-  const Part& cornerTopLeft() const { return cornerTopLeft_; }
-  const Part& cornerTopRight() const { return cornerTopRight_; }
-  const Part& cornerBottomLeft() const { return cornerBottomLeft_; }
-  const Part& cornerBottomRight() const { return cornerBottomRight_; }
-  const Part& intersection() const { return intersection_; }
-  const Part& connectorLeft() const { return connectorLeft_; }
-  const Part& connectorRight() const { return connectorRight_; }
-  const Part& connectorTop() const { return connectorTop_; }
-  const Part& connectorBottom() const { return connectorBottom_; }
+    // only looked up while rendering in parallel, see `genRows()`
+    auto row = middles_.find(widths);
+    if (row != middles_.end())
+    {
+      auto it = row->second.find(nextWidths);
+      if (it != row->second.end()) return it->second;
+    }
 
-  Border& horizontal(const uint32_t glyph)
-  {
-    horizontal_.glyph(glyph);
-    return *this;
-  }
-  Border& vertical(const uint32_t glyph)
-  {
-    vertical_.glyph(glyph);
-    return *this;
-  }
-  Border& cornerTopLeft(const uint32_t glyph)
-  {
-    cornerTopLeft_.glyph(glyph);
-    return *this;
+    middlesCount_++;
+    return middles_[widths]
+      .emplace(nextWidths, getBorderMiddle(widths, nextWidths))
+      .first->second;
   }
-  Border& cornerTopRight(const uint32_t glyph)
+
+  // forgets the separators if there are too many of them, the references to
+  // them must not be used after that
+  void trimMiddles() const
   {
-    cornerTopRight_.glyph(glyph);
-    return *this;
+    if (middlesCount_ <= MAX_MEMOIZED_SEPARATORS) return;
+
+    middles_.clear();
+    middlesCount_ = 0;
   }
-  Border& cornerBottomLeft(const uint32_t glyph)
+
+  void warmBorder() const
   {
-    cornerBottomLeft_.glyph(glyph);
-    return *this;
+    border_.horizontal().str();
+    border_.vertical().str();
+    border_.cornerTopLeft().str();
+    border_.cornerTopRight().str();
+    border_.cornerBottomLeft().str();
+    border_.cornerBottomRight().str();
+    border_.intersection().str();
+    border_.connectorLeft().str();
+    border_.connectorRight().str();
+    border_.connectorTop().str();
+    border_.connectorBottom().str();
   }
-  Border& cornerBottomRight(const uint32_t glyph)
+
+  // renders the rows that changed since the last `str()` again, with the
+  // borders around them if their widths changed, and splices them into the
+  // cached output. returns false if the whole table must be rendered again
+  bool update() const
   {
-    cornerBottomRight_.glyph(glyph);
-    return *this;
+    trimMiddles();
+    const size_t size = rows_.size();
+
+    std::vector<size_t> changed;
+    for (size_t i = 0; i < size; ++i)
+    {
+      const Row& row = rows_[i];
+
+      if (row.generation() != layout_.generations[i] ||
+          row.columns().size() != layout_.widths[i].size())
+        changed.push_back(i);
+    }
+
+    if (changed.empty()) return true;
+
+    for (const size_t i : changed)
+      checkWidth(i);
+
+    // the changed content may change the widths of all the rows
+    if (autoFit())
+    {
+      refreshFits();
+      if (fits_ != layout_.fits) return false;
+    }
+
+    // the parts of the output to generate again
+    std::vector<bool> parts(size, false);
+    bool header = false, footer = false;
+
+    for (const size_t i : changed)
+    {
+      parts[i] = true;
+      layout_.generations[i] = rows_[i].generation();
+
+      std::vector<size_t> widths = genWidths(i);
+      if (widths == layout_.widths[i]) continue;
+
+      layout_.widths[i] = std::move(widths);
+
+      // the borders around the row
+      if (i > 0) parts[i - 1] = true;
+      if (i == 0) header = true;
+      if (i + 1 == size) footer = true;
+    }
+
+    std::vector<size_t> offsets(size + 1, layout_.header);
+    for (size_t i = 0; i < size; ++i)
+      offsets[i + 1] = offsets[i] + layout_.lengths[i];
+
+    // from the end to the start, so the offsets stay valid
+    if (footer)
+      str_.replace(offsets[size], std::string::npos,
+                   getBorderFooter(layout_.widths.back()));
+
+    std::string part;
+    for (size_t i = size; i-- > 0;)
+    {
+      if (!parts[i]) continue;
+
+      part.clear();
+      const size_t length = appendRow(part, layout_, i, 0, true);
+
+      str_.replace(offsets[i], layout_.lengths[i], part);
+      layout_.lengths[i] = length;
+    }
+
+    if (header)
+    {
+      part = getBorderHeader(layout_.widths.front());
+      part += '\n';
+
+      str_.replace(0, layout_.header, part);
+      layout_.header = part.size();
+    }
+
+    return true;
   }
-  Border& intersection(const uint32_t glyph)
+
+  // the vertical border of a row, the table's one unless the row has its own
+  const Border::Part& vertical(const Row& row) const
   {
-    intersection_.glyph(glyph);
-    return *this;
+    const auto& vertical = row.config().vertical();
+    return vertical.glyph() == '\0' ? border_.vertical() : vertical;
   }
-  Border& connectorLeft(const uint32_t glyph)
+  static size_t calculateWidth(const std::vector<size_t>& widths,
+                               size_t& unspecified)
   {
-    connectorLeft_.glyph(glyph);
-    return *this;
+    size_t width = 0;
+
+    for (const size_t w : widths)
+    {
+      if (w == 0) unspecified++;
+      else width += w;
+    }
+
+    return width;
   }
-  Border& connectorRight(const uint32_t glyph)
+
+  static void setWidth(std::vector<size_t>& widths, size_t width)
   {
-    connectorRight_.glyph(glyph);
-    return *this;
+    size_t indivWidth = width / widths.size();
+    size_t rest = width % widths.size();
+
+    for (auto& w : widths)
+    {
+      w = indivWidth + (rest > 0);
+      rest -= (rest > 0);
+    }
+
+    // if there's still a rest
+    if (rest > 0) widths.back() = indivWidth + rest;
   }
-  Border& connectorTop(const uint32_t glyph)
+
+  static void setUnspecifiedWidth(std::vector<size_t>& widths,
+                                  size_t unspecified, size_t width)
   {
-    connectorTop_.glyph(glyph);
-    return *this;
+    size_t indivWidth = width / unspecified;
+    size_t rest = width % unspecified;
+
+    size_t lastUnsp = 0;
+    for (size_t i = 0; i < widths.size(); ++i)
+    {
+      auto& w = widths[i];
+      if (w != 0) continue;
+
+      w = indivWidth + (rest > 0);
+      rest -= (rest > 0);
+      lastUnsp = i;
+    }
+
+    // if there's still a rest
+    if (rest > 0) widths[lastUnsp] = indivWidth + rest;
   }
-  Border& connectorBottom(const uint32_t glyph)
+
+  detail::Layout genLayout() const
   {
-    connectorBottom_.glyph(glyph);
-    return *this;
+    detail::Layout layout;
+    layout.widths.reserve(rows_.size());
+
+    trimMiddles();
+    checkWidth();
+    if (autoFit())
+    {
+      refreshFits();
+      layout.fits = fits_;
+    }
+
+    for (size_t i = 0; i < rows_.size(); ++i)
+      layout.widths.push_back(genWidths(i));
+
+    return layout;
   }
 
-  static Border Default()
+  // computes the auto-fit widths again if a row changed since the last
+  // time. a changed row gets a new generation, and its number of columns is
+  // checked too since removing a column may leave the generation as it was
+  void refreshFits() const
   {
-    // already default constructed
-    return {};
+    const uint64_t generation = this->generation();
+
+    bool current = generation == fitsGen_ && fitsRows_.size() == rows_.size();
+    for (size_t i = 0; i < rows_.size() && current; ++i)
+    {
+      current = fitsRows_[i].first == rows_[i].generation() &&
+                fitsRows_[i].second == rows_[i].columns().size();
+    }
+
+    if (current) return;
+
+    fits_ = genFits();
+    fitsGen_ = generation;
+
+    fitsRows_.clear();
+    fitsRows_.reserve(rows_.size());
+    for (const auto& row : rows_)
+      fitsRows_.emplace_back(row.generation(), row.columns().size());
   }
-  static Border Filled(const uint32_t c)
+
+  // the auto-fit widths for every number of columns, from the narrowest
+  // and the widest widths of the columns in all the rows. the columns with
+  // an explicit width in some row keep the largest one
+  std::vector<std::vector<size_t>> genFits() const
   {
-    Border border;
-    border.horizontal_ = c;
-    border.vertical_ = c;
+    struct Fit {
+      std::vector<size_t> widths, minimum, maximum;
+    };
+    using Fits = std::vector<Fit>;
 
-    border.cornerTopLeft_ = c;
-    border.cornerTopRight_ = c;
-    border.cornerBottomLeft_ = c;
-    border.cornerBottomRight_ = c;
+    auto collect = [this](Fits& fits, const size_t first, const size_t last) {
+      for (size_t i = first; i < last; ++i)
+      {
+        const auto& columns = rows_[i].columns();
+        if (fits.size() <= columns.size()) fits.resize(columns.size() + 1);
 
-    border.intersection_ = c;
+        Fit& fit = fits[columns.size()];
+        if (fit.widths.empty())
+        {
+          fit.widths.assign(columns.size(), 0);
+          fit.minimum.assign(columns.size(), MIN_COLUMN_WIDTH);
+          fit.maximum.assign(columns.size(), MIN_COLUMN_WIDTH);
+        }
 
-    border.connectorLeft_ = c;
-    border.connectorRight_ = c;
-    border.connectorTop_ = c;
-    border.connectorBottom_ = c;
+        for (size_t j = 0; j < columns.size(); ++j)
+        {
+          const Column& column = columns[j];
+          fit.widths[j] = (std::max)(fit.widths[j], column.config().width());
+          fit.minimum[j] = (std::max)(fit.minimum[j], column.minWidth());
+          fit.maximum[j] = (std::max)(fit.maximum[j], column.maxWidth());
+        }
+      }
+    };
 
-    return border;
+    const size_t size = rows_.size();
+    const size_t tasks = (size + ROWS_PER_TASK - 1) / ROWS_PER_TASK;
+
+    Fits fits;
+    if (!config_.parallel() || tasks <= 1)
+      collect(fits, 0, size);
+
+    // the columns are measured concurrently, then merged
+    else
+    {
+      std::vector<Fits> parts(tasks);
+      detail::parallelFor(config_.executor_.get(), config_.threads_, tasks,
+                          [&](const size_t task) {
+        const size_t first = task * ROWS_PER_TASK;
+        collect(parts[task], first, (std::min)(first + ROWS_PER_TASK, size));
+      });
+
+      for (const Fits& part : parts)
+      {
+        if (fits.size() < part.size()) fits.resize(part.size());
+
+        for (size_t k = 0; k < part.size(); ++k)
+        {
+          if (part[k].widths.empty()) continue;
+          if (fits[k].widths.empty())
+          {
+            fits[k] = part[k];
+            continue;
+          }
+
+          for (size_t j = 0; j < k; ++j)
+          {
+            fits[k].widths[j] = (std::max)(fits[k].widths[j], part[k].widths[j]);
+            fits[k].minimum[j] = (std::max)(fits[k].minimum[j], part[k].minimum[j]);
+            fits[k].maximum[j] = (std::max)(fits[k].maximum[j], part[k].maximum[j]);
+          }
+        }
+      }
+    }
+
+    std::vector<std::vector<size_t>> widths(fits.size());
+    for (size_t k = 1; k < fits.size(); ++k)
+    {
+      if (fits[k].widths.empty()) continue;
+
+      const size_t available = config_.width() - (k + 1);
+      widths[k] = detail::fitWidths(std::move(fits[k].widths), fits[k].minimum,
+                                    fits[k].maximum, available);
+    }
+
+    return widths;
   }
-  static Border None()
+
+  // throws if a row can't fit in the table's width
+  void checkWidth() const
   {
-    return Filled(U'\0');
+    for (size_t i = 0; i < rows_.size(); ++i)
+      checkWidth(i);
   }
-  static Border Blank()
+  void checkWidth(const size_t index) const
   {
-    return Filled(U' ');
+    const size_t width = config_.width();
+    const size_t columns = rows_[index].columns().size();
+
+    size_t minWidth = (columns * (MIN_COLUMN_WIDTH + 1)) + 1;
+    if (minWidth > width)
+    {
+      throw std::runtime_error(
+        "layout error: row " + std::to_string(index) +
+        " must a minimum width of " + std::to_string(minWidth) +
+        ", but found " + std::to_string(width));
+    }
   }
-  static Border Modern()
+
+  // the columns widths of a row, they only depend on the row itself unless
+  // the table auto-fits its columns
+  std::vector<size_t> genWidths(const size_t index) const
   {
-    Border border;
-    border.horizontal_ = U'─';
-    border.vertical_ = U'│';
+    const auto& columns = rows_[index].columns();
+    if (columns.empty()) return {};
 
-    border.cornerTopLeft_ = U'┌';
-    border.cornerTopRight_ = U'┐';
-    border.cornerBottomLeft_ = U'└';
-    border.cornerBottomRight_ = U'┘';
+    if (!config_.columns().empty()) return resolveWidths(columns.size());
+    if (config_.autoFit())
+    {
+      // `refreshFits()` is called before the rows are laid out
+      if (columns.size() >= fits_.size() || fits_[columns.size()].size() != columns.size())
+        throw std::logic_error("layout error: the auto-fit widths are out of date");
 
-    border.intersection_ = U'┼';
+      return fits_[columns.size()];
+    }
 
-    border.connectorLeft_ = U'├';
-    border.connectorRight_ = U'┤';
-    border.connectorTop_ = U'┬';
-    border.connectorBottom_ = U'┴';
+    // start with the widths the columns asked for
+    std::vector<size_t> widths;
+    widths.reserve(columns.size());
 
-    return border;
-  }
-  static Border Double()
-  {
-    Border border;
-    border.horizontal_ = U'═';
-    border.vertical_ = U'║';
+    for (const auto& column : columns)
+      widths.push_back(column.config().width());
 
-    border.cornerTopLeft_ = U'╔';
-    border.cornerTopRight_ = U'╗';
-    border.cornerBottomLeft_ = U'╚';
-    border.cornerBottomRight_ = U'╝';
+    if (widths.empty()) return widths;
 
-    border.intersection_ = U'╬';
+    const size_t estimatedWidth = config_.width() - (columns.size() + 1);
 
-    border.connectorLeft_ = U'╠';
-    border.connectorRight_ = U'╣';
-    border.connectorTop_ = U'╦';
-    border.connectorBottom_ = U'╩';
+    size_t unspecified = 0;
+    const size_t rowWidth = calculateWidth(widths, unspecified);
 
-    return border;
+    // everything is fine skip
+    if (rowWidth == estimatedWidth && unspecified == 0)
+      return widths;
+
+    // set just the unspecified columns widths
+    if (rowWidth < estimatedWidth && unspecified != 0)
+      setUnspecifiedWidth(widths, unspecified, estimatedWidth - rowWidth);
+
+    // set/restore the width of all the columns
+    else
+      setWidth(widths, estimatedWidth);
+
+    return widths;
   }
-  static Border Rounded()
+
+  // the `Config::columns()` widths of the rows with `columns` columns
+  const std::vector<size_t>& resolveWidths(const size_t columns) const
   {
-    Border border;
-    border.horizontal_ = U'─';
-    border.vertical_ = U'│';
+    if (resolvedGen_ != config_.gen_)
+    {
+      resolved_.clear();
+      resolvedGen_ = config_.gen_;
+    }
 
-    border.cornerTopLeft_ = U'╭';
-    border.cornerTopRight_ = U'╮';
-    border.cornerBottomLeft_ = U'╰';
-    border.cornerBottomRight_ = U'╯';
+    if (resolved_.size() <= columns) resolved_.resize(columns + 1);
 
-    border.intersection_ = U'┼';
+    auto& widths = resolved_[columns];
+    if (widths.empty())
+    {
+      const size_t available = config_.width() - (columns + 1);
+      widths = detail::resolveWidths(config_.columns(), columns, available);
+    }
 
-    border.connectorLeft_ = U'├';
-    border.connectorRight_ = U'┤';
-    border.connectorTop_ = U'┬';
-    border.connectorBottom_ = U'┴';
+    return widths;
+  }
 
-    return border;
+  // appends `count` horizontal glyphs
+  void fill(std::string& out, const size_t count) const
+  {
+    border_.horizontal().fill(out, count);
   }
-  static Border Heavy()
+
+  std::string getBorderHeader(const std::vector<size_t>& widths) const
   {
-    Border border;
-    border.horizontal_ = U'━';
-    border.vertical_ = U'┃';
+    std::string header = border_.cornerTopLeft().str();
+    header.reserve(config_.width());
 
-    border.cornerTopLeft_ = U'┏';
-    border.cornerTopRight_ = U'┓';
-    border.cornerBottomLeft_ = U'┗';
-    border.cornerBottomRight_ = U'┛';
+    for (size_t i = 0; i < widths.size(); ++i)
+    {
+      fill(header, widths[i]);
 
-    border.intersection_ = U'╋';
+      if (i + 1 < widths.size()) header += border_.connectorTop().str();
+    }
 
-    border.connectorLeft_ = U'┣';
-    border.connectorRight_ = U'┫';
-    border.connectorTop_ = U'┳';
-    border.connectorBottom_ = U'┻';
+    header += border_.cornerTopRight().str();
+    return header;
+  }
+  std::string getBorderFooter(const std::vector<size_t>& widths) const
+  {
+    std::string footer = border_.cornerBottomLeft().str();
+    footer.reserve(config_.width());
 
-    return border;
+    for (size_t i = 0; i < widths.size(); ++i)
+    {
+      fill(footer, widths[i]);
+
+      if (i + 1 < widths.size()) footer += border_.connectorBottom().str();
+    }
+
+    footer += border_.cornerBottomRight().str();
+    return footer;
   }
 
-  void reset()
+  // merges the columns boundaries of the two rows, the boundaries of the
+  // row above are either intersections or bottom connectors, and the ones
+  // of the row below that fall in between are top connectors
+  std::string getBorderMiddle(const std::vector<size_t>& widths,
+                              const std::vector<size_t>& nextWidths) const
   {
-    horizontal_ = U'-'; // ─
-    vertical_ = U'|'; // │
+    std::string middle = border_.connectorLeft().str();
+    middle.reserve(config_.width());
 
-    cornerTopLeft_ = U'+'; // ┌
-    cornerTopRight_ = U'+'; // ┐
-    cornerBottomLeft_ = U'+'; // └
-    cornerBottomRight_ = U'+'; // ┘
+    // the positions of the boundaries, the left corner is at 0
+    size_t position = 0, next = 0, j = 0;
+    if (!nextWidths.empty()) next = nextWidths[0] + 1;
 
-    intersection_ = U'+'; // ┼
+    for (size_t i = 0; i < widths.size(); ++i)
+    {
+      const size_t boundary = position + widths[i] + 1;
 
-    connectorLeft_ = U'+'; // ├
-    connectorRight_ = U'+'; // ┤
-    connectorTop_ = U'-'; // ┬
-    connectorBottom_ = U'-'; // ┴
-  }
+      // the boundaries of the row below inside this column
+      while (j < nextWidths.size() && next < boundary)
+      {
+        fill(middle, next - position - 1);
+        middle += border_.connectorTop().str();
+        position = next;
 
-private:
-  Part horizontal_ = U'-'; // ─
-  Part vertical_ = U'|'; // │
+        if (++j < nextWidths.size()) next += nextWidths[j] + 1;
+      }
 
-  Part cornerTopLeft_ = U'+'; // ┌
-  Part cornerTopRight_ = U'+'; // ┐
-  Part cornerBottomLeft_ = U'+'; // └
-  Part cornerBottomRight_ = U'+'; // ┘
+      fill(middle, boundary - position - 1);
+      position = boundary;
 
-  Part intersection_ = U'+'; // ┼
+      const bool shared = j < nextWidths.size() && next == boundary;
+      if (shared && ++j < nextWidths.size()) next += nextWidths[j] + 1;
 
-  Part connectorLeft_ = U'+'; // ├
-  Part connectorRight_ = U'+'; // ┤
-  Part connectorTop_ = U'-'; // ┬
-  Part connectorBottom_ = U'-'; // ┴
-};
+      if (i + 1 >= widths.size()) continue;
 
-class Row {
-public:
-  class Config {
-  public:
-    explicit Config(bool& dirty_)
-      : dirty_(dirty_)
-    {
+      if (shared) middle += border_.intersection().str();
+      else middle += border_.connectorBottom().str();
     }
 
-    void hasBottom(bool has)
-    {
-      dirty_ = true;
-      hasBottom_ = has;
-    }
-    void vertical(Border::Part part)
+    middle += border_.connectorRight().str();
+    return middle;
+  }
+};
+// clang-format off
+}
+
+#if defined(_WIN32) || defined(_WIN64)
+#include "windows.h"
+#include <io.h>
+#endif
+
+namespace tabular {
+  inline void render(const char* str, const size_t len, FILE* out)
+  {
+    if (len == 0)
+      return;
+
+#if defined(_WIN32) || defined(_WIN64)
+    HANDLE handle;
+
+    if (out == stdout)
+      handle = GetStdHandle(STD_OUTPUT_HANDLE);
+    else if (out == stderr)
+      handle = GetStdHandle(STD_ERROR_HANDLE);
+    else
+      handle = reinterpret_cast<HANDLE>(_get_osfhandle(_fileno(out)));
+
+    if (handle == INVALID_HANDLE_VALUE)
+      return;
+
+    DWORD mode;
+    DWORD written;
+
+    if (!GetConsoleMode(handle, &mode))
     {
-      dirty_ = true;
-      vertical_ = std::move(part);
+      WriteFile(handle, str, static_cast<DWORD>(len), &written, nullptr);
+      return;
     }
 
-    bool hasBottom() const { return hasBottom_; }
-    const Border::Part& vertical() const { return vertical_; }
+    // convert UTF-8 to UTF-16 because it's Windows
+    const int ilen = static_cast<int>(len);
+    int wlen = MultiByteToWideChar(CP_UTF8, 0, str, ilen, nullptr, 0);
 
-    void reset()
+    // fallback
+    if (wlen <= 0)
     {
-      vertical_ = 0;
-      dirty_ = true;
+      WriteFile(handle, str, static_cast<DWORD>(len), &written, nullptr);
+      return;
     }
 
-  private:
-    friend class Row;
+    wchar_t* buffer = new wchar_t[wlen];
+    int result = MultiByteToWideChar(CP_UTF8, 0, str, ilen, buffer, wlen);
 
-    bool& dirty_;
-    bool hasBottom_ = true;
-    Border::Part vertical_ = 0;
-  };
+    if (result <= 0)
+    {
+      delete[] buffer;
+      WriteFile(handle, str, static_cast<DWORD>(len), &written, nullptr);
+      return;
+    }
 
-public:
-  Row() = default;
+    WriteConsoleW(handle, buffer, static_cast<DWORD>(wlen), &written, nullptr);
+    delete[] buffer;
+#else
+    fwrite(str, 1, len, out);
+#endif
+  }
 
-  // copy contructor
-  // NOTE: it's mandatory to initialize config_ with dirty_ to avoid a heap-use-after-free error
-  // from the address sanitizer, then copy the members of the other.config_ into our new one
-  // See column.h:200 note
-  Row(const Row& other)
-    : columns_(other.columns_), dirty_(other.dirty_), str_(other.str_), 
-    config_(dirty_) // CRUCIAL
+  inline void render(const std::string& str, FILE* out)
   {
-    config_.hasBottom_ = other.config_.hasBottom_;
-    config_.vertical_ = other.config_.vertical_;
+    render(str.data(), str.length(), out);
   }
 
-  explicit Row(std::vector<Column> columns)
-    : columns_(std::move(columns))
+  // streams the table into `out` row by row, without building its string
+  inline void render(const Table& table, FILE* out)
   {
+    table.render([out](const char* str, const size_t len) {
+      render(str, len, out);
+    });
   }
-  explicit Row(std::vector<std::string> columns)
+}
+
+namespace tabular {
+// clang-format off
+// the cells of a virtual table, e.g. behind a database cursor or a memory
+// mapped file. they are pulled one by one while the table is rendered
+class Source {
+public:
+  virtual ~Source() = default;
+
+  virtual size_t rows() const = 0;
+  virtual size_t columns() const = 0;
+
+  // sets the content of the cell at `row`, `column` and, optionally, its
+  // style and configuration. `cell` is reused from one cell to the next,
+  // it's cleared before every call
+  virtual void cell(size_t row, size_t column, Column& cell) const = 0;
+
+  // raises `width`, `minimum` and `maximum` to the largest explicit width,
+  // `Column::minWidth()` and `Column::maxWidth()` of the cells of `column`,
+  // e.g. for a source that can go through a column faster than through the
+  // rows. returns false to have the cells pulled row by row instead
+  virtual bool measure(size_t /* column */, size_t& /* width */,
+                       size_t& /* minimum */, size_t& /* maximum */) const
   {
-    columns_.reserve(columns.size());
+    return false;
+  }
+};
 
-    for (auto& column : columns)
-    {
-      columns_.emplace_back(std::move(column));
-    }
+// a table whose rows aren't kept, every row is pulled from the source,
+// wrapped, written to the sink then dropped, so there is no object per cell.
+// the columns have the same widths in every row, either explicitly with
+// `widths()`, from `config().columns()`, from the content of all the cells
+// with `config().autoFit()`, or shared evenly.
+// NOTE: the source must outlive the table
+class VirtualTable {
+public:
+  explicit VirtualTable(const Source& source, Border border = {})
+    : source_(&source)
+  {
+    table_.border(std::move(border));
   }
 
-  void columns(std::vector<Column> columns)
+  // the table's width, columns widths and border
+  Table::Config& config() { return table_.config(); }
+  const Table::Config& config() const { return table_.config(); }
+
+  Border& border() { return table_.border(); }
+  const Border& border() const { return table_.border(); }
+
+  // fixes the columns widths, instead of computing them on every render
+  VirtualTable& widths(std::vector<size_t> widths)
   {
-    dirty_ = true;
-    columns_ = std::move(columns);
+    widths_ = std::move(widths);
+    return *this;
   }
 
-  Config& config() { return config_; }
-  const Config& config() const { return config_; }
+  const std::vector<size_t>& widths() const { return widths_; }
 
-  std::vector<Column>& columns()
+  // writes the table to `sink` row by row, see `Table::render()`
+  template <typename Sink> void render(Sink&& sink) const
   {
-    dirty_ = true;
-    return columns_;
+    render(sink, 0, source_->rows());
   }
-  const std::vector<Column>& columns() const { return columns_; }
 
-  Column& column(int index)
+  // writes the rows [first, last) as a table of their own, the columns
+  // keep the widths they have in the whole table
+  template <typename Sink>
+  void render(Sink&& sink, const size_t first, size_t last) const
   {
-    dirty_ = true;
-    return columns_.at(index);
+    last = (std::min)(last, source_->rows());
+    if (first >= last) return;
+
+    const size_t columns = source_->columns();
+    if (columns == 0) return;
+
+    const std::vector<size_t> widths = genWidths(columns);
+    if (widths.size() != columns)
+    {
+      throw std::runtime_error(
+        "layout error: the source has " + std::to_string(columns) +
+        " columns, but the layout has " + std::to_string(widths.size()));
+    }
+
+    const Border::Part& vertical = table_.border().vertical();
+    const std::string middle = table_.getBorderMiddle(widths, widths);
+
+    // the cells are reused from one row to the next
+    Row row{std::vector<Column>(columns)};
+
+    std::string buffer;
+    buffer += table_.getBorderHeader(widths);
+    buffer += '\n';
+
+    for (size_t i = first; i < last; ++i)
+    {
+      pull(row, i);
+      row.write(buffer, widths, vertical);
+      buffer += '\n';
+
+      // the footer follows the last row
+      if (i + 1 >= last)
+        buffer += table_.getBorderFooter(widths);
+
+      else
+      {
+        buffer += middle;
+        buffer += '\n';
+      }
+
+      sink(buffer.data(), buffer.size());
+      buffer.clear();
+    }
   }
-  const Column& column(int index) const
+
+  std::string str() const { return str(0, source_->rows()); }
+  std::string str(const size_t first, const size_t last) const
   {
-    return columns_.at(index);
+    std::string str;
+    render([&str](const char* data, const size_t length) { str.append(data, length); },
+           first, last);
+
+    return str;
   }
 
-  Column& operator[](int index)
+private:
+  const Source* source_;
+
+  // configuration and border
+  Table table_;
+
+  std::vector<size_t> widths_;
+
+  void pull(Row& row, const size_t index) const
   {
-    dirty_ = true;
-    return columns_.at(index);
+    auto& cells = row.columns();
+    for (size_t j = 0; j < cells.size(); ++j)
+    {
+      cells[j].clr();
+      source_->cell(index, j, cells[j]);
+    }
   }
-  const Column& operator[](int index) const
+
+  // the columns widths, the same for every row. auto-fitting pulls every
+  // cell once to measure it, see `detail::fitWidths()`
+  std::vector<size_t> genWidths(const size_t columns) const
   {
-    return columns_.at(index);
+    if (!widths_.empty()) return widths_;
+
+    const size_t width = config().width();
+    size_t minWidth = (columns * (MIN_COLUMN_WIDTH + 1)) + 1;
+    if (minWidth > width)
+    {
+      throw std::runtime_error(
+        "layout error: the rows must have a minimum width of " +
+        std::to_string(minWidth) + ", but found " + std::to_string(width));
+    }
+
+    if (!config().columns().empty()) return table_.resolveWidths(columns);
+
+    std::vector<size_t> widths(columns, 0);
+    if (!config().autoFit())
+    {
+      Table::setWidth(widths, width - (columns + 1));
+      return widths;
+    }
+
+    std::vector<size_t> minimum(columns, MIN_COLUMN_WIDTH);
+    std::vector<size_t> maximum(columns, MIN_COLUMN_WIDTH);
+
+    bool measured = true;
+    for (size_t j = 0; j < columns && measured; ++j)
+      measured = source_->measure(j, widths[j], minimum[j], maximum[j]);
+
+    Row row{std::vector<Column>(columns)};
+    for (size_t i = 0; i < source_->rows() && !measured; ++i)
+    {
+      pull(row, i);
+
+      const auto& cells = row.columns();
+      for (size_t j = 0; j < columns; ++j)
+      {
+        widths[j] = (std::max)(widths[j], cells[j].config().width());
+        minimum[j] = (std::max)(minimum[j], cells[j].minWidth());
+        maximum[j] = (std::max)(maximum[j], cells[j].maxWidth());
+      }
+    }
+
+    return detail::fitWidths(std::move(widths), minimum, maximum,
+                             width - (columns + 1));
   }
+};
+// clang-format on
+
+// streams the virtual table into `out` row by row
+inline void render(const VirtualTable& table, FILE* out)
+{
+  table.render([out](const char* str, const size_t len) {
+    render(str, len, out);
+  });
+}
+} // namespace tabular
 
-  void clr()
+namespace tabular {
+// clang-format off
+// a table stored column by column, for tables whose rows all have the same
+// columns. the contents of a column are kept back to back in a single
+// string, its configuration and style once, and only the cells that differ
+// keep their own. it's rendered through a `VirtualTable`:
+//
+//   ColumnStore store(3);
+//   store.addRow({"1", "Alice", "admin"});
+//   render(VirtualTable(store), stdout);
+//
+// NOTE: the rows are only appended, see `addRow()`
+class ColumnStore : public Source {
+public:
+  explicit ColumnStore(const size_t columns)
+    : fields_(columns)
   {
-    columns_.clear();
-    str_.clear();
-    config_.reset();
-    dirty_ = false;
   }
 
-  const std::string& str() const
+  size_t rows() const override { return rows_; }
+  size_t columns() const override { return fields_.size(); }
+
+  ColumnStore& addRow(const std::vector<std::string>& row)
   {
-    if (dirty_)
+    if (row.size() != fields_.size())
     {
-      str_ = genStr();
-      dirty_ = false;
+      throw std::runtime_error(
+        "layout error: the row has " + std::to_string(row.size()) +
+        " columns, but the table has " + std::to_string(fields_.size()));
     }
 
-    return str_;
-  }
-
-private:
-  // cache
-  mutable bool dirty_ = false;
-  mutable std::string str_;
+    for (size_t j = 0; j < row.size(); ++j)
+    {
+      Field& field = fields_[j];
+      field.pool += row[j];
+      field.offsets.push_back(field.pool.size());
+    }
 
-  std::vector<Column> columns_;
-  Config config_{dirty_};
+    rows_++;
+    return *this;
+  }
 
-  std::string genStr() const
+  // reserves the memory of `rows` rows of `bytes` bytes per cell on average
+  void reserve(const size_t rows, const size_t bytes = 0)
   {
-    if (columns_.empty()) return "";
-    const size_t maxLines = getMaxLines();
+    for (auto& field : fields_)
+    {
+      field.offsets.reserve(rows);
+      field.pool.reserve(rows * bytes);
+    }
+  }
 
-    std::string rowStr;
-    // average
-    rowStr.reserve(DEFAULT_WIDTH * maxLines + (columns_.size() + 1));
+  std::string content(const size_t row, const size_t column) const
+  {
+    const Field& field = fields_.at(column);
+    const size_t begin = row > 0 ? field.offsets.at(row - 1) : 0;
 
-    const auto& vertical = config().vertical().str();
-    for (size_t i = 0; i < maxLines; ++i)
-    {
-      if (!rowStr.empty()) rowStr.push_back('\n');
-      rowStr.append(vertical);
+    return field.pool.substr(begin, field.offsets.at(row) - begin);
+  }
 
-      for (const auto& column : columns_)
-      {
-        const auto& lines = column.lines();
+  // the configuration and style of every cell of the column
+  Column::Config& config(const size_t column) { return fields_.at(column).format.config; }
+  Column::Style& style(const size_t column) { return fields_.at(column).format.style; }
 
-        if (lines.size() > i)
-          rowStr.append(lines[i]);
-        else
-          rowStr.append(column.genEmptyLine());
+  const Column::Config& config(const size_t column) const { return fields_.at(column).format.config; }
+  const Column::Style& style(const size_t column) const { return fields_.at(column).format.style; }
 
-        rowStr.append(vertical);
-      }
-    }
+  // the configuration and style of a single cell, they start as the
+  // column's ones and don't follow them after that
+  Column::Config& config(const size_t row, const size_t column) { return format(row, column).config; }
+  Column::Style& style(const size_t row, const size_t column) { return format(row, column).style; }
 
-    return rowStr;
-  }
-  size_t getMaxLines() const
+  void cell(const size_t row, const size_t column, Column& cell) const override
   {
-    size_t maxLines = 0;
+    const Format& format = this->format(row, column);
 
-    for (const auto& column : columns_)
-      maxLines = (std::max)(maxLines, column.lines().size());
-
-    return maxLines;
+    cell.config() = format.config;
+    cell.style() = format.style;
+    cell.content(content(row, column));
   }
-};
 
-class Table {
-public:
-  class Config {
-  public:
-    explicit Config(bool& dirty_) : dirty_(dirty_)
+  // the cells of a column are measured one after the other
+  bool measure(const size_t column, size_t& width, size_t& minimum,
+               size_t& maximum) const override
+  {
+    Column cell;
+    for (size_t i = 0; i < rows_; ++i)
     {
-    }
+      this->cell(i, column, cell);
 
-    void width(const size_t width)
-    {
-      dirty_ = true;
-      width_ = width;
+      width = (std::max)(width, cell.config().width());
+      minimum = (std::max)(minimum, cell.minWidth());
+      maximum = (std::max)(maximum, cell.maxWidth());
     }
 
-    size_t width() const { return width_; }
+    return true;
+  }
 
-    void reset()
-    {
-      width_ = DEFAULT_WIDTH;
-      dirty_ = true;
-    }
+private:
+  struct Format {
+    Column::Config config;
+    Column::Style style;
+  };
 
-  private:
-    bool& dirty_;
-    size_t width_ = DEFAULT_WIDTH;
+  struct Field {
+    // the contents back to back, and where each one ends
+    std::string pool;
+    std::vector<size_t> offsets;
+
+    Format format;
+
+    // the cells with their own format
+    std::map<size_t, Format> formats;
   };
 
-public:
-  Table() = default;
+  std::vector<Field> fields_;
+  size_t rows_ = 0;
 
-  explicit Table(std::vector<Row> rows, Border border = {})
-    : rows_(std::move(rows)), border_(std::move(border)), dirty_(true)
+  Format& format(const size_t row, const size_t column)
   {
-  }
+    if (row >= rows_) throw std::out_of_range("the row doesn't exist");
 
-  void rows(std::vector<Row> rows)
-  {
-    rows_ = std::move(rows);
-    dirty_ = true;
+    Field& field = fields_.at(column);
+    auto it = field.formats.find(row);
+    if (it == field.formats.end())
+      it = field.formats.emplace(row, field.format).first;
+
+    return it->second;
   }
-  void border(Border border)
+  const Format& format(const size_t row, const size_t column) const
   {
-    border_ = std::move(border);
-    dirty_ = true;
+    const Field& field = fields_.at(column);
+    auto it = field.formats.find(row);
+
+    return it == field.formats.end() ? field.format : it->second;
   }
+};
+// clang-format on
+} // namespace tabular
 
-  Table& addRow(Row row)
+namespace tabular {
+// clang-format off
+// the rows of a table in another order, or some of them, without copying
+// them: only their indices are kept, sorted and filtered. the view is
+// rendered like the table, the columns keep their widths in the whole table
+// and the rows reuse their cached output.
+// NOTE: the table must outlive the view, and the view must be reset if
+// rows are removed from the table
+class TableView {
+public:
+  explicit TableView(const Table& table)
+    : table_(&table)
   {
-    rows_.emplace_back(std::move(row));
-    dirty_ = true;
-    return *this;
+    reset();
   }
-  Table& addRow(std::vector<std::string> row)
+
+  // every row in the table's order
+  TableView& reset()
   {
-    rows_.emplace_back(std::move(row));
-    dirty_ = true;
+    indices_.resize(table_->rows().size());
+    std::iota(indices_.begin(), indices_.end(), size_t(0));
     return *this;
   }
 
-  Config& config() { return config_; }
-  const Config& config() const { return config_; }
-
-  Border& border()
+  // orders the rows with `less(const Row&, const Row&)`, the equal rows
+  // keep their order
+  template <typename Less> TableView& sort(Less less)
   {
-    dirty_ = true;
-    return border_;
-  }
-  const Border& border() const { return border_; }
+    const auto& rows = table_->rows();
+    std::stable_sort(indices_.begin(), indices_.end(),
+                     [&](const size_t a, const size_t b) { return less(rows[a], rows[b]); });
 
-  std::vector<Row>& rows()
-  {
-    dirty_ = true;
-    return rows_;
+    return *this;
   }
-  const std::vector<Row>& rows() const { return rows_; }
 
-  Row& row(int index)
+  // orders the rows by the cells of `keys`, see `Table::sort()`
+  TableView& sort(const std::vector<SortKey>& keys)
   {
-    dirty_ = true;
-    return rows_.at(index);
+    table_->sortRows(indices_, keys);
+    return *this;
   }
-  const Row& row(int index) const { return rows_.at(index); }
 
-  Row& operator[](int index)
+  // keeps the rows for which `keep(const Row&)` is true
+  template <typename Predicate> TableView& filter(Predicate keep)
   {
-    dirty_ = true;
-    return rows_.at(index);
+    const auto& rows = table_->rows();
+    indices_.erase(std::remove_if(indices_.begin(), indices_.end(),
+                                  [&](const size_t i) { return !keep(rows[i]); }),
+                   indices_.end());
+
+    return *this;
   }
-  const Row& operator[](int index) const
+
+  // the indices of the rows in the table, in the view's order
+  const std::vector<size_t>& indices() const { return indices_; }
+  size_t size() const { return indices_.size(); }
+
+  const Row& operator[](const size_t index) const
   {
-    return rows_.at(index);
+    return table_->rows().at(indices_.at(index));
   }
 
-  void clr()
+  // writes the rows of the view to `sink`, see `Table::render()`
+  template <typename Sink> void render(Sink&& sink) const
   {
-    rows_.clear();
-    config_.reset();
-    border_.reset();
-    str_.clear();
-    dirty_ = false;
+    render(sink, 0, indices_.size());
   }
 
-  const std::string& str() const
+  // writes the rows [first, last) of the view as a table of their own
+  template <typename Sink>
+  void render(Sink&& sink, const size_t first, size_t last) const
   {
-    if (dirty_)
+    last = (std::min)(last, indices_.size());
+    if (first >= last) return;
+
+    for (size_t i = first; i < last; ++i)
     {
-      str_ = genStr();
-    dirty_ = false;
-    }
+      if (indices_[i] >= table_->rows().size())
+        throw std::out_of_range("the view has rows that don't exist");
 
-    return str_;
-  }
+      table_->checkWidth(indices_[i]);
+    }
 
-private:
-  // cache
-  mutable bool dirty_ = false;
-  mutable std::string str_;
+    if (table_->autoFit()) table_->refreshFits();
 
-  std::vector<Row> rows_;
-  Config config_{dirty_};
-  Border border_;
+    const std::vector<size_t>& indices = indices_;
+    table_->renderRows(sink, first, last,
+                       [&indices](const size_t i) { return indices[i]; }, true);
+  }
 
-  std::string genStr() const
+  std::string str() const { return str(0, indices_.size()); }
+  std::string str(const size_t first, const size_t last) const
   {
-    // avoid reference
-    auto rows = rows_;
-    if (rows.empty()) return "";
+    std::string str;
+    render([&str](const char* data, const size_t length) { str.append(data, length); },
+           first, last);
 
-    std::string tableStr;
-    tableStr.reserve(rows.size() * config_.width());
-
-    adjustWidth(rows);
-    configureRows(rows);
-
-    tableStr += getBorderHeader(rows) + '\n';
+    return str;
+  }
 
-    const size_t rowsSize = rows_.size();
-    for (size_t i = 0; i < rowsSize; ++i)
-    {
-      auto& row = rows[i];
+private:
+  const Table* table_;
+  std::vector<size_t> indices_;
+};
+// clang-format on
 
-      tableStr += row.str() + '\n';
+// streams the view into `out` row by row
+inline void render(const TableView& view, FILE* out)
+{
+  view.render([out](const char* str, const size_t len) {
+    render(str, len, out);
+  });
+}
+} // namespace tabular
 
-      if (i + 1 < rowsSize && row.config().hasBottom())
-        tableStr += getBorderMiddle(rows, i) + '\n';
-    }
+namespace tabular {
+// clang-format off
+// writes a table row by row as the rows arrive, e.g. for live logs.
+// the columns layout is fixed up front, either explicitly with `widths()`
+// or from the first rows (see `sample()`), then the top border is written
+// once, every row as soon as it's added, and the bottom border on close.
+// NOTE: the rows aren't kept, the memory doesn't grow with their number
+class Writer {
+public:
+  using Sink = std::function<void(const char*, size_t)>;
 
-    tableStr += getBorderFooter(rows);
-    return tableStr;
+  explicit Writer(Sink sink, Border border = {})
+    : sink_(std::move(sink))
+  {
+    table_.border(std::move(border));
   }
-  static size_t calculateWidth(const Row& row, size_t& unspecified)
+  explicit Writer(FILE* out, Border border = {})
+    : Writer([out](const char* str, const size_t len) { render(str, len, out); },
+             std::move(border))
   {
-    const auto& columns = row.columns();
-    if (columns.empty()) return 0;
-    size_t width = 0;
+  }
 
-    for (const auto& column : columns)
-    {
-      size_t w = column.config().width();
+  Writer(const Writer&) = delete;
+  Writer& operator=(const Writer&) = delete;
 
-      if (w == 0) unspecified++;
-      else width += w;
+  ~Writer()
+  {
+    // the destructor must not throw, call `close()` to handle the errors
+    try
+    {
+      close();
+    }
+    catch (...)
+    {
     }
-
-    return width;
   }
 
-  static void setWidth(Row& row, size_t width)
-  {
-    auto& columns = row.columns();
+  // the table's width and border, the changes made after the first row is
+  // written are ignored
+  Table::Config& config() { return table_.config(); }
+  const Table::Config& config() const { return table_.config(); }
 
-    size_t indivWidth = width / columns.size();
-    size_t rest = width % columns.size();
+  Border& border() { return table_.border(); }
+  const Border& border() const { return table_.border(); }
 
-    for (auto& column : columns)
-    {
-      column.config().width(indivWidth + (rest > 0));
-      rest -= (rest > 0);
-    }
+  // fixes the columns widths, every row must have as many columns. they
+  // can't be changed once the first row is written
+  Writer& widths(std::vector<size_t> widths)
+  {
+    checkStarted();
+    widths_ = std::move(widths);
+    return *this;
+  }
 
-    // if there's still a rest
-    if (rest > 0) columns.back().config().width(indivWidth + rest);
+  // lays the columns out from the first `count` rows, they are held back
+  // until then (or until `close()`)
+  Writer& sample(const size_t count)
+  {
+    sample_ = count > 0 ? count : 1;
+    return *this;
   }
 
-  static void setUnspecifiedWidth(Row& row, size_t unspecified, size_t width)
+  const std::vector<size_t>& widths() const { return widths_; }
+
+  Writer& addRow(Row row)
   {
-    std::vector<Column>& columns = row.columns();
+    if (closed_) throw std::logic_error("writer error: the writer is closed");
 
-    size_t indivWidth = width / unspecified;
-    size_t rest = width % unspecified;
+    // the table's columns widths don't need the content
+    if (widths_.empty() && !table_.config().columns().empty())
+    {
+      checkWidth(row.columns().size());
+      widths_ = table_.resolveWidths(row.columns().size());
+    }
 
-    size_t lastUnsp = 0;
-    for (size_t i = 0; i < columns.size(); ++i)
+    if (widths_.empty())
     {
-      auto& column = columns[i];
-      if (column.config().width() != 0) continue;
+      sampled_.emplace_back(std::move(row));
+      if (sampled_.size() >= sample_) flushSampled();
 
-      column.config().width(indivWidth + (rest > 0));
-      rest -= (rest > 0);
-      lastUnsp = i;
+      return *this;
     }
 
-    // if there's still a rest
-    if (rest > 0) columns[lastUnsp].config().width(indivWidth + rest);
+    write(row);
+    return *this;
+  }
+  Writer& addRow(std::vector<std::string> row)
+  {
+    return addRow(Row(std::move(row)));
   }
 
-  void adjustWidth(std::vector<Row>& rows) const
+  // writes the held back rows and the bottom border, rows can't be added
+  // after that
+  void close()
   {
-    if (rows.empty()) return;
+    if (closed_) return;
 
-    size_t width = config_.width();
-    for (size_t i = 0; i < rows.size(); ++i)
-    {
-      Row& row = rows[i];
+    flushSampled();
+    finish();
+  }
 
-      // check the minimum width first
-      {
-        size_t minWidth = (row.columns().size() * (MIN_COLUMN_WIDTH + 1)) + 1;
-        if (minWidth > width)
-        {
-          throw std::runtime_error(
-            "layout error: row " + std::to_string(i) +
-            " must a minimum width of " + std::to_string(minWidth) +
-            ", but found " + std::to_string(width));
-        }
-      }
+private:
+  Sink sink_;
 
-      const size_t estimatedWidth = width - (row.columns().size() + 1);
+  // configuration and border
+  Table table_;
 
-      size_t unspecified = 0;
-      const size_t rowWidth = calculateWidth(row, unspecified);
+  // the columns layout and the rows held back to compute it
+  std::vector<size_t> widths_;
+  std::vector<Row> sampled_;
+  size_t sample_ = 1;
 
-      // everything is fine skip
-      if (rowWidth == estimatedWidth && unspecified == 0)
-        continue;
+  // the border as it was when the first row was written, and the memoized
+  // separator between two rows and bottom border
+  Border border_;
+  std::string middle_;
+  std::string footer_;
 
-      // set just the unspecified columns widths
-      if (rowWidth < estimatedWidth && unspecified != 0)
-        setUnspecifiedWidth(row, unspecified, estimatedWidth - rowWidth);
+  // the last written row wants a bottom border
+  bool hasBottom_ = false;
+  bool started_ = false;
+  bool closed_ = false;
 
-      // set/restore the width of all the columns
-      else
-        setWidth(row, estimatedWidth);
-    }
-  }
-  void configureRows(std::vector<Row>& rows) const
+  std::string buffer_;
+
+  // a held back row that doesn't fit the layout closes the writer, the rows
+  // after it are dropped so none of them is written twice
+  void flushSampled()
   {
-    auto& verticalBorder = border_.vertical();
-    for (auto& row : rows)
+    if (sampled_.empty()) return;
+
+    std::vector<Row> rows = std::move(sampled_);
+    sampled_.clear();
+    sampled_.shrink_to_fit();
+
+    try
     {
-      auto& config = row.config();
+      if (widths_.empty()) widths_ = sampleWidths(rows);
 
-      if (config.vertical().glyph() == '\0')
-        config.vertical(verticalBorder);
+      for (const auto& row : rows)
+        write(row);
+    }
+    catch (...)
+    {
+      finish();
+      throw;
     }
   }
 
-  static std::vector<size_t> connections(const Row& row)
+  // writes the bottom border, rows can't be added after that
+  void finish()
   {
-    std::vector<size_t> connections;
-    connections.reserve(row.columns().size());
-
-    size_t track = 1;
-    for (const Column& column : row.columns())
-    {
-      track += column.config().width();
-      connections.push_back(track++);
-    }
+    if (closed_) return;
+    closed_ = true;
 
-    return connections;
+    if (started_) sink_(footer_.data(), footer_.size());
   }
-  std::string getBorderHeader(std::vector<Row>& rows) const
+
+  void write(const Row& row)
   {
-    const auto& columns = rows[0].columns();
+    const size_t columns = row.columns().size();
+    if (columns != widths_.size())
+    {
+      throw std::runtime_error(
+        "layout error: the row has " + std::to_string(columns) +
+        " columns, but the layout has " + std::to_string(widths_.size()));
+    }
 
-    std::string header = border_.cornerTopLeft().str();
-    header.reserve(config_.width());
+    buffer_.clear();
 
-    const std::string& horizontal = border_.horizontal().str();
-    for (size_t i = 0; i < columns.size(); ++i)
+    if (!started_)
     {
-      size_t width = columns[i].config().width();
-
-      for (size_t j = 0; j < width; ++j)
-        header += horizontal;
+      checkWidths();
+      buffer_ += table_.getBorderHeader(widths_);
+      buffer_ += '\n';
+      middle_ = table_.getBorderMiddle(widths_, widths_);
+      footer_ = table_.getBorderFooter(widths_);
+      footer_ += '\n';
+      border_ = table_.border();
+      started_ = true;
+    }
 
-      if (i + 1 < columns.size()) header += border_.connectorTop().str();
+    // the separator of the previous row, now that it isn't the last one
+    else if (hasBottom_)
+    {
+      buffer_ += middle_;
+      buffer_ += '\n';
     }
 
-    header += border_.cornerTopRight().str();
-    return header;
+    const Border::Part& vertical = row.config().vertical();
+    row.write(buffer_, widths_, vertical.glyph() == '\0' ? border_.vertical() : vertical);
+    buffer_ += '\n';
+
+    hasBottom_ = row.config().hasBottom();
+    sink_(buffer_.data(), buffer_.size());
   }
-  std::string getBorderFooter(std::vector<Row>& rows) const
+
+  // the widths that fit the content of the sampled rows, the columns with
+  // an explicit width keep the largest one like `Table::genFits()`, see
+  // `detail::fitWidths()`
+  std::vector<size_t> sampleWidths(const std::vector<Row>& rows) const
   {
-    const auto& columns = rows.back().columns();
+    const size_t columns = rows.front().columns().size();
+    const size_t width = config().width();
+    checkWidth(columns);
 
-    std::string footer = border_.cornerBottomLeft().str();
-    footer.reserve(config_.width());
+    std::vector<size_t> widths(columns, 0);
+    std::vector<size_t> minimum(columns, MIN_COLUMN_WIDTH);
+    std::vector<size_t> maximum(columns, MIN_COLUMN_WIDTH);
 
-    const std::string& horizontal = border_.horizontal().str();
-    for (size_t i = 0; i < columns.size(); ++i)
+    for (const auto& row : rows)
     {
-      size_t width = columns[i].config().width();
-
-      for (size_t j = 0; j < width; ++j)
-        footer += horizontal;
+      const auto& cols = row.columns();
+      for (size_t i = 0; i < cols.size() && i < columns; ++i)
+      {
+        widths[i] = (std::max)(widths[i], cols[i].config().width());
 
-      if (i + 1 < columns.size()) footer += border_.connectorBottom().str();
+        minimum[i] = (std::max)(minimum[i], cols[i].minWidth());
+        maximum[i] = (std::max)(maximum[i], cols[i].maxWidth());
+      }
     }
 
-    footer += border_.cornerBottomRight().str();
-    return footer;
+    return detail::fitWidths(std::move(widths), minimum, maximum,
+                             width - (columns + 1));
   }
-  std::string getBorderMiddle(std::vector<Row>& rows, size_t index) const
-  {
-    const auto nextRowConnections = connections(rows[index + 1]);
 
-    std::string middle = border_.connectorLeft().str();
-    middle.reserve(config_.width());
+  void checkStarted() const
+  {
+    if (started_)
+      throw std::logic_error("writer error: the first row is already written");
+  }
 
-    const auto& columns = rows[index].columns();
+  // throws if the columns widths are narrower than the minimum or don't
+  // fit in the table's width, the same way `checkWidth()` does
+  void checkWidths() const
+  {
+    const size_t width = config().width();
 
-    size_t tracker = 0;
-    const std::string& horizontal = border_.horizontal().str();
-    for (size_t i = 0; i < columns.size(); ++i)
+    size_t rowWidth = widths_.size() + 1;
+    for (const size_t w : widths_)
     {
-      size_t width = columns[i].config().width();
-
-      for (size_t j = 0; j < width; ++j)
+      if (w < MIN_COLUMN_WIDTH)
       {
-        if (detail::bisearch(nextRowConnections, ++tracker))
-          middle += border_.connectorTop().str();
-        else
-          middle += horizontal;
+        throw std::runtime_error(
+          "layout error: the columns must have a minimum width of " +
+          std::to_string(MIN_COLUMN_WIDTH) + ", but found " + std::to_string(w));
       }
-      tracker++;
-
-      if (i + 1 >= columns.size()) continue;
 
-      if (detail::bisearch(nextRowConnections, tracker))
-        middle += border_.intersection().str();
-      else
-        middle += border_.connectorBottom().str();
+      rowWidth += w;
     }
 
-    middle += border_.connectorRight().str();
-    return middle;
-  }
-};
-
-#if defined(_WIN32) || defined(_WIN64)
-#include "windows.h"
-#include <io.h>
-#endif
-
-inline void render(const std::string& str, FILE* out)
-{
-  if (str.empty())
-    return;
-
-#if defined(_WIN32) || defined(_WIN64)
-  HANDLE handle;
-
-  if (out == stdout)
-    handle = GetStdHandle(STD_OUTPUT_HANDLE);
-  else if (out == stderr)
-    handle = GetStdHandle(STD_ERROR_HANDLE);
-  else
-    handle = reinterpret_cast<HANDLE>(_get_osfhandle(_fileno(out)));
-
-  if (handle == INVALID_HANDLE_VALUE)
-    return;
-
-  DWORD mode;
-  DWORD written;
-
-  if (!GetConsoleMode(handle, &mode))
-  {
-    WriteFile(handle, str.c_str(), str.length(), &written, nullptr);
-    return;
+    if (rowWidth > width)
+    {
+      throw std::runtime_error(
+        "layout error: the rows must have a width of at most " +
+        std::to_string(width) + ", but found " + std::to_string(rowWidth));
+    }
   }
 
-  // convert UTF-8 to UTF-16 because it's Windows
-  int wlen = MultiByteToWideChar(CP_UTF8, 0, str.c_str(), -1, nullptr, 0);
-
-  // fallback
-  if (wlen <= 0)
+  // throws if `columns` columns can't fit in the table's width
+  void checkWidth(const size_t columns) const
   {
-    WriteFile(handle, str.c_str(), str.length(), &written, nullptr);
-    return;
-  }
-
-  wchar_t* buffer = new wchar_t[wlen];
-  int result = MultiByteToWideChar(CP_UTF8, 0, str.c_str(), -1, buffer, wlen);
+    const size_t width = config().width();
 
-  if (result <= 0)
-  {
-    delete[] buffer;
-    WriteFile(handle, str.c_str(), str.length(), &written, nullptr);
-    return;
+    size_t minWidth = (columns * (MIN_COLUMN_WIDTH + 1)) + 1;
+    if (minWidth > width)
+    {
+      throw std::runtime_error(
+        "layout error: the rows must have a minimum width of " +
+        std::to_string(minWidth) + ", but found " + std::to_string(width));
+    }
   }
-
-  WriteConsoleW(handle, buffer, static_cast<DWORD>(wlen - 1), &written, nullptr);
-  delete[] buffer;
-#else
-  fwrite(str.c_str(), 1, str.length(), out);
-#endif
-}
-}
+};
+// clang-format on
+} // namespace tabular
 
 /*
   ------------------------------------------------------------------------------
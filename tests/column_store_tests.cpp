@@ -0,0 +1,54 @@
+#include "gtest/gtest.h"
+#include "../include/tabular/column_store.h"
+
+// to avoid repeating
+using namespace tabular;
+
+TEST(column_store_tests, storage)
+{
+  ColumnStore store(2);
+  store.addRow({"1", "first"});
+  store.addRow({"", "漢字"});
+  store.addRow({"3", ""});
+
+  EXPECT_EQ(store.rows(), 3);
+  EXPECT_EQ(store.columns(), 2);
+  EXPECT_EQ(store.content(0, 1), "first");
+  EXPECT_EQ(store.content(1, 0), "");
+  EXPECT_EQ(store.content(1, 1), "漢字");
+  EXPECT_EQ(store.content(2, 0), "3");
+
+  EXPECT_THROW(store.addRow({"4"}), std::runtime_error);
+  EXPECT_THROW(store.content(3, 0), std::out_of_range);
+  EXPECT_THROW(store.style(3, 0), std::out_of_range);
+}
+
+TEST(column_store_tests, same_output)
+{
+  ColumnStore store(3);
+  Table table;
+  for (size_t i = 0; i < 10; ++i)
+  {
+    std::vector<std::string> row = {std::to_string(i), "a longer description " + std::to_string(i), "OK"};
+    store.addRow(row);
+    table.addRow(row);
+  }
+
+  // once per column, and a single cell
+  store.style(2).fg(Color::Green);
+  store.config(0).align(Align::Right);
+  store.style(4, 2).fg(Color::Red);
+  for (size_t i = 0; i < 10; ++i)
+  {
+    table[i][2].style().fg(i == 4 ? Color::Red : Color::Green);
+    table[i][0].config().align(Align::Right);
+  }
+
+  VirtualTable virt(store);
+  EXPECT_EQ(virt.str(), table.str());
+
+  // the columns are measured one by one
+  virt.config().autoFit(true);
+  table.config().autoFit(true);
+  EXPECT_EQ(virt.str(), table.str());
+}
@@ -123,5 +123,131 @@ TEST(column_tests, nested_styles)
   ASSERT_EQ(lines.size(), 3);
   EXPECT_EQ(lines[0], " \x1b[36mHello, World!!\x1b[0m ");
   EXPECT_EQ(lines[1], " \x1b[36m\x1b[31mLet's start \x1b[0m   ");
-  EXPECT_EQ(lines[2], " \x1b[36m\x1b[31mthe journey\x1b[0m    ");
-}
\ No newline at end of file
+  EXPECT_EQ(lines[2], " \x1b[31mthe journey\x1b[0m    ");
+}
+
+TEST(column_tests, active_styles_restoring)
+{
+  // every escape sequence stays active until the reset
+  std::string content;
+  for (int i = 0; i < 20; ++i)
+    content += "\x1b[1m\x1b[31m\x1b[4m\x1b[32mword ";
+  content += "\x1b[22;24m\x1b[48;5;200mtail\x1b[0m";
+
+  Column column(content);
+  column.config().width(12);
+
+  auto lines = column.lines();
+  ASSERT_GT(lines.size(), 2);
+
+  // the lines after the first one start with a single sequence
+  EXPECT_EQ(lines[1].substr(0, 11), " \x1b[1;4;32mw");
+  EXPECT_EQ(lines.back(), " \x1b[32;48;5;200mtail\x1b[0m       ");
+}
+
+TEST(column_tests, hard_wrapping)
+{
+  Column column(std::string(25, 'a'));
+  column.config().width(12);
+
+  auto lines = column.lines();
+  ASSERT_EQ(lines.size(), 3);
+  EXPECT_EQ(lines[0], " aaaaaaaaa- ");
+  EXPECT_EQ(lines[1], " aaaaaaaaa- ");
+  EXPECT_EQ(lines[2], " aaaaaaa    ");
+
+  // a character wider than the whole line is still emitted
+  column.content("漢字");
+  column.config().width(3);
+  lines = column.lines();
+  ASSERT_EQ(lines.size(), 2);
+  EXPECT_EQ(lines[0], " 漢 ");
+  EXPECT_EQ(lines[1], " 字 ");
+}
+
+TEST(column_tests, ignored_tokens)
+{
+  // other space characters and non SGR escape sequences are dropped
+  Column column("one\ttwo\x1b[2K three\r\nfour");
+  column.config().width(12);
+
+  auto lines = column.lines();
+  ASSERT_EQ(lines.size(), 3);
+  EXPECT_EQ(lines[0], " onetwo     ");
+  EXPECT_EQ(lines[1], " three      ");
+  EXPECT_EQ(lines[2], " four       ");
+}
+
+TEST(column_tests, single_line)
+{
+  Column column("OK");
+  column.config().width(8);
+  column.config().align(Align::Center);
+
+  auto lines = column.lines();
+  ASSERT_EQ(lines.size(), 1);
+  EXPECT_EQ(lines[0], "   OK   ");
+
+  column.style().fg(Color::Red);
+  column.style().base(Color::Blue);
+  lines = column.lines();
+  ASSERT_EQ(lines.size(), 1);
+  EXPECT_EQ(lines[0], "\x1b[44m   \x1b[31mOK\x1b[0m\x1b[44m   \x1b[0m");
+}
+
+TEST(column_tests, content_info)
+{
+  Column column("hello wide 漢字\n\x1b[31mlongestword\x1b[0m x");
+
+  const auto& info = column.contentInfo();
+  EXPECT_FALSE(info.ascii);
+  EXPECT_TRUE(info.hasEscapes);
+  EXPECT_TRUE(info.hasNewlines);
+  EXPECT_FALSE(info.hasSpaces);
+  EXPECT_EQ(info.dw, 28);
+  EXPECT_EQ(info.longestLine, 15);
+  EXPECT_EQ(info.longestToken, 11);
+
+  // including the default padding
+  EXPECT_EQ(column.minWidth(), 13);
+  EXPECT_EQ(column.maxWidth(), 17);
+
+  // changing the content refreshes the descriptor
+  column.content() = "a\tb";
+  EXPECT_TRUE(column.contentInfo().ascii);
+  EXPECT_TRUE(column.contentInfo().hasSpaces);
+  EXPECT_EQ(column.contentInfo().dw, 2);
+}
+
+TEST(column_tests, change_tracking)
+{
+  Column column("Hello");
+  column.config().width(16);
+  const uint64_t generation = column.generation();
+
+  // setting the same values or reading through mutable references
+  column.config().width(16);
+  column.style().resetFg();
+  column.content("Hello");
+  EXPECT_EQ(column.content(), "Hello");
+  EXPECT_EQ(column[0], 'H');
+  EXPECT_EQ(column.generation(), generation);
+
+  // writing through them
+  column.content() += ", World";
+  EXPECT_NE(column.generation(), generation);
+  EXPECT_EQ(column.lines()[0], " Hello, World   ");
+
+  column[0] = 'J';
+  EXPECT_EQ(column.lines()[0], " Jello, World   ");
+  EXPECT_EQ(column.contentInfo().dw, 12);
+
+  // writing the same character, or editing in place
+  const uint64_t edited = column.generation();
+  column[0] = 'J';
+  EXPECT_EQ(column.generation(), edited);
+
+  column.edit([](std::string& content) { content.replace(0, 5, "Hi"); });
+  EXPECT_NE(column.generation(), edited);
+  EXPECT_EQ(column.lines()[0], " Hi, World      ");
+}
@@ -0,0 +1,127 @@
+#include "gtest/gtest.h"
+#include "../include/tabular/string_utils.h"
+
+// to avoid repeating
+using namespace tabular;
+
+TEST(string_utils_tests, ascii_display_width)
+{
+  EXPECT_EQ(string_utils::dw(""), 0);
+  EXPECT_EQ(string_utils::dw("Hello, World"), 12);
+
+  // long enough to go through the vectorized path and the scalar tail
+  const std::string ascii(1000, 'a');
+  EXPECT_EQ(string_utils::dw(ascii), 1000);
+  EXPECT_EQ(string_utils::dw(ascii + "bcd"), 1003);
+
+  // control characters are zero width
+  EXPECT_EQ(string_utils::dw(std::string(40, 'a') + "\t\r" + std::string(40, 'b')), 80);
+  EXPECT_EQ(string_utils::dw("a\x7f" "b"), 2);
+}
+
+TEST(string_utils_tests, mixed_display_width)
+{
+  // runs that stop on non-ascii bytes at different offsets
+  for (size_t offset = 0; offset < 70; ++offset)
+  {
+    std::string str(offset, 'x');
+    str += "漢字";
+    str += std::string(offset, 'y');
+    str += "é😀";
+
+    EXPECT_EQ(string_utils::dw(str), offset * 2 + 4 + 1 + 2);
+  }
+}
+
+TEST(string_utils_tests, escapes_display_width)
+{
+  for (size_t offset = 0; offset < 70; ++offset)
+  {
+    std::string str(offset, 'x');
+    str += "\x1b[38;2;255;0;0m";
+    str += std::string(offset, 'y');
+    str += "\x1b[0m";
+
+    EXPECT_EQ(string_utils::dw(str), offset * 2);
+  }
+}
+
+TEST(string_utils_tests, wcwidth_matches_ranges)
+{
+  using namespace detail;
+
+  const int combiningMax = sizeof(combining) / sizeof(Range) - 1;
+  const int wideMax = sizeof(wide) / sizeof(Range) - 1;
+
+  for (uint32_t ucs = 0; ucs <= 0x10FFFF + 16; ++ucs)
+  {
+    size_t expected = 1;
+    if (bisearch(ucs, combining, combiningMax)) expected = 0;
+    else if (bisearch(ucs, wide, wideMax)) expected = 2;
+
+    ASSERT_EQ(string_utils::wcwidth(ucs), expected) << "U+" << std::hex << ucs;
+  }
+}
+
+TEST(string_utils_tests, length_aware_display_width)
+{
+  const char* str = "Hello, 漢字";
+
+  // measure a prefix in place
+  EXPECT_EQ(string_utils::dw(str, 5), 5);
+  EXPECT_EQ(string_utils::dw(str, 10), 9);
+
+  // a truncated sequence is invalid, each byte counts as 1
+  EXPECT_EQ(string_utils::dw(str, 8), 8);
+  EXPECT_EQ(string_utils::dw(str, 9), 9);
+
+  // embedded NUL characters don't stop the measurement
+  const std::string nul("abc\0def", 7);
+  EXPECT_EQ(string_utils::dw(nul), 6);
+  EXPECT_EQ(string_utils::dw(nul.c_str()), 3);
+
+#ifdef TABULAR_HAS_STRING_VIEW
+  EXPECT_EQ(string_utils::dw(std::string_view(str).substr(7)), 4);
+#endif
+}
+
+TEST(string_utils_tests, utf8_char_length)
+{
+  const std::string str = "a\xc3\xa9漢😀\x80\xe6\xbc";
+
+  EXPECT_EQ(string_utils::utf8CharLen(str.data(), str.length(), 0), 1);
+  EXPECT_EQ(string_utils::utf8CharLen(str.data(), str.length(), 1), 2);
+  EXPECT_EQ(string_utils::utf8CharLen(str.data(), str.length(), 3), 3);
+  EXPECT_EQ(string_utils::utf8CharLen(str.data(), str.length(), 6), 4);
+
+  // continuation byte, truncated sequence and out of range
+  EXPECT_EQ(string_utils::utf8CharLen(str.data(), str.length(), 10), 0);
+  EXPECT_EQ(string_utils::utf8CharLen(str.data(), str.length(), 11), 0);
+  EXPECT_EQ(string_utils::utf8CharLen(str.data(), str.length(), 13), 0);
+
+  EXPECT_EQ(string_utils::readUtf8Char(str, 3), "漢");
+  EXPECT_EQ(string_utils::readUtf8Char(str, 10), "");
+}
+
+TEST(string_utils_tests, repeat)
+{
+  std::string out = "+";
+  string_utils::repeat(out, "ab", 2, 5);
+  EXPECT_EQ(out, "+ababababab");
+
+  string_utils::repeat(out, "─", 3, 0);
+  EXPECT_EQ(out, "+ababababab");
+
+  out.clear();
+  string_utils::repeat(out, "─", 3, 3);
+  EXPECT_EQ(out, "───");
+}
+
+TEST(string_utils_tests, strip_escapes)
+{
+  EXPECT_EQ(string_utils::stripEscapes("plain"), "plain");
+  EXPECT_EQ(string_utils::stripEscapes("\x1b[31m12.5\x1b[0m ms"), "12.5 ms");
+  EXPECT_EQ(string_utils::stripEscapes("a\x1b[2Kb\x1b[38;5;200m"), "ab");
+  EXPECT_EQ(string_utils::stripEscapes("漢\x1b[1m字"), "漢字");
+  EXPECT_EQ(string_utils::stripEscapes("cut\x1b[3"), "cut");
+}
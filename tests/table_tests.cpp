@@ -0,0 +1,544 @@
+#include "gtest/gtest.h"
+#include "../include/tabular/render.h"
+
+#include <type_traits>
+
+// to avoid repeating
+using namespace tabular;
+
+TEST(table_tests, move_semantics)
+{
+  static_assert(std::is_nothrow_move_constructible<Column>::value, "");
+  static_assert(std::is_nothrow_move_constructible<Row>::value, "");
+  static_assert(std::is_nothrow_move_constructible<Table>::value, "");
+  static_assert(std::is_nothrow_move_assignable<Column>::value, "");
+  static_assert(std::is_nothrow_move_assignable<Row>::value, "");
+  static_assert(std::is_nothrow_move_assignable<Table>::value, "");
+
+  // the cells keep working after the vector moved them around
+  std::vector<Column> columns;
+  for (int i = 0; i < 100; ++i)
+    columns.emplace_back(std::to_string(i));
+
+  columns[0].config().width(6);
+  ASSERT_EQ(columns[0].lines().size(), 1);
+  EXPECT_EQ(columns[0].lines()[0], " 0    ");
+
+  Table table;
+  table.addRow({"a", "b"});
+  table.config().width(20);
+
+  Table expected = table;
+  Table moved(std::move(table));
+  EXPECT_EQ(moved.str(), expected.str());
+
+  moved = Table();
+  moved.addRow({"a", "b"});
+  moved.config().width(20);
+  EXPECT_EQ(moved.str(), expected.str());
+}
+
+TEST(table_tests, independent_copies)
+{
+  Table table;
+  table.addRow({"a", "b"});
+  table.config().width(20);
+
+  const std::string str = table.str();
+
+  // the copy's configuration doesn't touch the original's cache
+  Table copy = table;
+  copy.config().width(30);
+  copy[0][0].config().align(Align::Right);
+
+  EXPECT_NE(copy.str(), str);
+  EXPECT_EQ(table.str(), str);
+
+  table.config().width(30);
+  EXPECT_NE(table.str(), str);
+}
+
+TEST(table_tests, layout_keeps_cells)
+{
+  Table table;
+  table.addRow({"a", "b"});
+  table.addRow({"c", "d"});
+  table.config().width(20);
+
+  const std::string str = table.str();
+
+  // the widths are assigned by the table, not written into the cells
+  const Table& view = table;
+  EXPECT_EQ(view[0][0].config().width(), 0);
+  EXPECT_EQ(view[1][1].config().width(), 0);
+
+  // the cells are wrapped with the table's widths and cached there
+  ASSERT_EQ(view[0][0].lines(9).size(), 1);
+  EXPECT_EQ(view[0][0].lines(9)[0], " a       ");
+
+  // changing a cell only changes its row
+  table[1][0].content("e");
+  const std::string changed = table.str();
+  EXPECT_NE(changed, str);
+  EXPECT_EQ(changed.substr(0, 42), str.substr(0, 42));
+}
+
+TEST(table_tests, streaming_render)
+{
+  Table table;
+  table.addRow({"id", "status"});
+  table.addRow({"1", "OK"});
+  table.addRow({"2", "a status that wraps into a few lines"});
+  table[1].config().hasBottom(false);
+  table.config().width(30);
+
+  // one call for every row with its bottom border
+  size_t calls = 0;
+  std::string streamed;
+  table.render([&](const char* str, size_t len) {
+    streamed.append(str, len);
+    ++calls;
+  });
+
+  EXPECT_EQ(calls, 3);
+  EXPECT_EQ(streamed, table.str());
+
+  // the cached string is written at once
+  calls = 0;
+  streamed.clear();
+  table.render([&](const char* str, size_t len) {
+    streamed.append(str, len);
+    ++calls;
+  });
+
+  EXPECT_EQ(calls, 1);
+  EXPECT_EQ(streamed, table.str());
+
+  // into a file
+  FILE* file = std::tmpfile();
+  ASSERT_NE(file, nullptr);
+
+  table[0][0].content("ID");
+  render(table, file);
+
+  std::string written(table.str().size(), '\0');
+  std::rewind(file);
+  EXPECT_EQ(std::fread(&written[0], 1, written.size(), file), written.size());
+  EXPECT_EQ(std::fgetc(file), EOF);
+  EXPECT_EQ(written, table.str());
+
+  std::fclose(file);
+}
+
+TEST(table_tests, partial_updates)
+{
+  auto build = [](const std::string& cell, size_t width) {
+    Table table;
+    table.addRow({"id", "name", "status"});
+    table.addRow({"1", "first", "OK"});
+    table.addRow({"2", "second", "OK"});
+    table.addRow({"3", "third", "OK"});
+    table.config().width(40);
+
+    table[2][2].content(cell);
+    table[2][1].config().width(width);
+    return table;
+  };
+
+  Table table = build("OK", 0);
+  const std::string str = table.str();
+
+  // only the changed row is rendered again
+  table[2][2].content("FAILED");
+  EXPECT_EQ(table.str(), build("FAILED", 0).str());
+  EXPECT_EQ(table.str().size(), str.size());
+  EXPECT_EQ(table.str().find("second"), str.find("second"));
+
+  // and the borders around it when its widths change
+  table[2][1].config().width(8);
+  EXPECT_EQ(table.str(), build("FAILED", 8).str());
+
+  // the last row changes the bottom border
+  table[3][0].config().width(20);
+  Table expected = build("FAILED", 8);
+  expected[3][0].config().width(20);
+  EXPECT_EQ(table.str(), expected.str());
+
+  // reading doesn't change anything
+  const std::string& same = table.str();
+  EXPECT_EQ(&same, &table.str());
+  EXPECT_EQ(table[1][1].content(), "first");
+  EXPECT_EQ(table.str(), expected.str());
+}
+
+TEST(table_tests, mutable_references)
+{
+  Table table;
+  table.addRow({"a", "b"});
+  table.addRow({"c", "d"});
+  table.config().width(20);
+
+  const std::string str = table.str();
+
+  // iterating through mutable references keeps the output
+  for (auto& row : table.rows())
+    for (auto& column : row.columns())
+      EXPECT_FALSE(column.content().empty());
+  table.border().vertical().glyph(U'|');
+  EXPECT_EQ(&table.str(), &table.str());
+  EXPECT_EQ(table.str(), str);
+
+  // but writing through them changes it
+  table.border().vertical().glyph(U'#');
+  EXPECT_EQ(table.str().find('|'), std::string::npos);
+
+  table.rows().pop_back();
+  table.rows()[0].columns().pop_back();
+
+  Table expected;
+  expected.addRow({"a"});
+  expected.config().width(20);
+  expected.border().vertical(U'#');
+  EXPECT_EQ(table.str(), expected.str());
+}
+
+TEST(table_tests, parallel_render)
+{
+  auto build = []() {
+    Table table;
+    table.config().width(60);
+
+    for (size_t i = 0; i < 2000; ++i)
+    {
+      const std::string id = std::to_string(i);
+      std::vector<std::string> row = {id, "\x1b[31mservice\x1b[0m-" + id,
+                                      std::string(i % 40, 'x') + " done"};
+      if (i % 7 == 0) row.pop_back();
+
+      table.addRow(row);
+      table[i].config().hasBottom(i % 3 != 0);
+    }
+    return table;
+  };
+
+  const std::string expected = build().str();
+
+  Table threaded = build();
+  threaded.config().threads(4);
+  EXPECT_EQ(threaded.str(), expected);
+
+  // any executor, the tasks run in reverse here
+  Table executed = build();
+  size_t tasks = 0;
+  const Executor reversed = [&](size_t count, const std::function<void(size_t)>& task) {
+    tasks += count;
+    for (size_t i = count; i-- > 0;)
+      task(i);
+  };
+  executed.config().executor(reversed);
+  EXPECT_EQ(executed.str(), expected);
+  EXPECT_GT(tasks, 1);
+
+  // streamed in batches
+  Table streamed = build();
+  streamed.config().threads(3);
+
+  std::string out;
+  streamed.render([&](const char* str, size_t len) { out.append(str, len); });
+  EXPECT_EQ(out, expected);
+
+  // a batch holds a few tasks per executor task at once
+  streamed.config().executor(reversed, 1);
+
+  size_t batches = 0;
+  out.clear();
+  streamed.render([&](const char* str, size_t len) { out.append(str, len); batches++; });
+  EXPECT_EQ(out, expected);
+  EXPECT_EQ(batches, (streamed.rows().size() + ROWS_PER_TASK * 4 - 1) / (ROWS_PER_TASK * 4));
+
+  // the changed rows are spliced in as usual
+  threaded[1500][1].content("changed");
+  Table changed = build();
+  changed[1500][1].content("changed");
+  EXPECT_EQ(threaded.str(), changed.str());
+}
+
+TEST(table_tests, auto_fit)
+{
+  Table table;
+  table.addRow({"id", "status", "message"});
+  table.addRow({"1", "OK", "a long free text message that wraps around"});
+  table.addRow({"2", "FAILED", "short"});
+  table.config().width(60);
+  table.config().autoFit(true);
+
+  // the short columns fit their content, the message takes the rest
+  const std::string middle = "+----+--------+" + std::string(44, '-') + "+";
+
+  const std::string& str = table.str();
+  EXPECT_EQ(str.find(middle), str.find('\n') + 1 + 61);
+  EXPECT_NE(str.find(middle, str.find("wraps")), std::string::npos);
+
+  // every row shares the widths
+  EXPECT_NE(str.find("| 1  | OK     | a long free text message that wraps around |"),
+            std::string::npos);
+
+  // the widths follow the content, the message wraps as little as it can
+  table[2][1].content("TIMED OUT");
+  EXPECT_NE(table.str().find("| 1  | OK        | a long free text message that wraps     |\n"
+                             "|    |           | around                                  |"),
+            std::string::npos);
+
+  // explicit widths are kept
+  table[0][0].config().width(6);
+  EXPECT_NE(table.str().find("| 1    | OK        |"), std::string::npos);
+}
+
+TEST(table_tests, column_widths)
+{
+  Table table;
+  table.addRow({"id", "name", "description"});
+  table.addRow({"1", "first", "the first one"});
+  table.config().width(50);
+  table.config().columns({ColumnWidth::Fixed(6), ColumnWidth::Percent(25),
+                          ColumnWidth::Flex()});
+
+  // 46 characters for the columns, 25% of them are 11
+  const std::string middle = "+------+-----------+" + std::string(29, '-') + "+";
+  EXPECT_NE(table.str().find(middle), std::string::npos);
+
+  // the rows with another number of columns get their own widths, the
+  // columns past the spec are flexible
+  table.addRow({"2", "second", "the second one", "extra"});
+  table.config().columns({ColumnWidth::Fixed(4), ColumnWidth::Flex().max(10),
+                          ColumnWidth::Flex(2)});
+  EXPECT_NE(table.str().find("| 2  | second   | the second one      | extra    |"),
+            std::string::npos);
+
+  // the columns' own widths are ignored
+  table[0][0].config().width(20);
+  EXPECT_NE(table.str().find("| 1  | first    |"), std::string::npos);
+
+  // they must fit
+  table.config().columns({ColumnWidth::Fixed(60)});
+  EXPECT_THROW(table.str(), std::runtime_error);
+
+  // the fixed columns never grow, the rest goes to the percentage ones or
+  // else the table is narrower
+  Table fixed;
+  fixed.addRow({"a", "b"});
+  fixed.config().width(30);
+  fixed.config().columns({ColumnWidth::Fixed(5), ColumnWidth::Fixed(6)});
+  EXPECT_EQ(fixed.str(), "+------------+\n| a   | b    |\n+------------+");
+
+  fixed.config().columns({ColumnWidth::Fixed(5), ColumnWidth::Percent(10)});
+  EXPECT_NE(fixed.str().find("| a   | b" + std::string(20, ' ') + "|"), std::string::npos);
+}
+
+TEST(table_tests, separators)
+{
+  Table table;
+  table.border(Border::Modern());
+  table.addRow({"a", "b"});
+  table.addRow({"a", "b", "c"});
+  table.addRow({"a", "b", "c"});
+  table.config().width(20);
+
+  // the boundaries of both rows are merged
+  const std::string& str = table.str();
+  EXPECT_NE(str.find("├──────┬──┴──┬─────┤"), std::string::npos);
+  EXPECT_NE(str.find("├──────┼─────┼─────┤"), std::string::npos);
+}
+
+TEST(table_tests, colored_border)
+{
+  Table table;
+  table.addRow({"a"});
+  table.config().width(12);
+  table.border().horizontal().fg(Color::Red);
+
+  // the color is set once for the whole line
+  const std::string line = "+\x1b[31m" + std::string(10, '-') + "\x1b[0m+";
+  EXPECT_EQ(table.str(), line + "\n| a        |\n" + line);
+
+  // and for the multibyte glyphs
+  table.border().horizontal().glyph(U'─');
+
+  std::string glyphs;
+  for (int i = 0; i < 10; ++i)
+    glyphs += "─";
+  EXPECT_EQ(table.str().substr(0, glyphs.size() + 10), "+\x1b[31m" + glyphs + "\x1b[0m");
+}
+
+TEST(table_tests, border_escapes)
+{
+  Table table;
+  table.addRow({"a"});
+  table.config().width(5);
+
+  // the sequence ends with 'm', not with the last parameter's ';'
+  table.border().horizontal().bg(Color::Blue);
+  EXPECT_EQ(table.str().substr(0, 9), "+\x1b[44m---");
+
+  // an RGB background keeps its prefix after a foreground
+  table.border().horizontal().fg(Color::Red).bg(Rgb(1, 2, 3));
+  EXPECT_EQ(table.str().substr(0, 20), "+\x1b[31;48;2;1;2;3m---");
+}
+
+TEST(table_tests, exact_size)
+{
+  Table table;
+  EXPECT_EQ(table.size(), 0);
+
+  table.config().width(40);
+  table.border(Border::Modern());
+  table.border().horizontal().fg(Color::Red);
+  table.addRow({"Name", "Description"});
+  table.addRow({"tabular", "a header-only library to render tables, with styles"});
+  table[1][1].style().fg(Color::Green);
+  table.addRow({"漢字", ""});
+  table[2].config().hasBottom(false);
+
+  const size_t size = table.size();
+  EXPECT_EQ(size, table.str().size());
+  EXPECT_EQ(table.size(), size);
+
+  // after a change
+  table[0][0].content("Library");
+  EXPECT_EQ(table.size(), table.str().size());
+}
+
+TEST(table_tests, row_window)
+{
+  Table table;
+  table.config().width(30);
+  for (int i = 0; i < 5; ++i)
+    table.addRow({"row " + std::to_string(i), "some content"});
+  table[2].config().hasBottom(false);
+
+  // the same as a table of these rows only
+  Table part;
+  part.config().width(30);
+  part.rows({table[1], table[2], table[3]});
+  EXPECT_EQ(table.str(1, 4), part.str());
+
+  EXPECT_EQ(table.str(0, 5), table.str());
+  EXPECT_EQ(table.str(4, 100), table.str(4, 5));
+  EXPECT_EQ(table.str(3, 3), "");
+
+  // the auto-fit widths come from all the rows
+  table.config().autoFit(true);
+  table[0][0].content("a long first column");
+
+  const std::string str = table.str();
+  const std::string window = table.str(3, 5);
+  EXPECT_EQ(window.substr(0, window.find('\n')), str.substr(0, str.find('\n')));
+  EXPECT_EQ(window.substr(window.rfind('\n')), str.substr(str.rfind('\n')));
+
+  // and follow the rows written after a window was rendered
+  table[1][0].content("an even longer first column");
+  EXPECT_EQ(table.str(3, 5).substr(0, window.find('\n')), table.str().substr(0, str.find('\n')));
+  EXPECT_NE(table.str(3, 5), window);
+
+  // through references kept from before, even when the columns change
+  Row& row = table[0];
+  table.str(0, 2);
+  row.columns().push_back(Column("xyz"));
+  const std::string added = table.str(0, 2);
+  EXPECT_EQ(added.substr(0, added.find('\n')), table.str().substr(0, added.find('\n')));
+
+  // a window doesn't hide the changes from the cached output
+  table[4][1].content("a much longer second column");
+  table.str(3, 5);
+  Table expected(table.rows());
+  expected.config() = table.config();
+  EXPECT_EQ(table.str(), expected.str());
+}
+
+TEST(table_tests, auto_fit_columns)
+{
+  Table table;
+  table.config().width(30);
+  table.config().autoFit(true);
+  table.addRow({"a", "b"});
+  table.str();
+
+  // removing a column that isn't the last change
+  table[0][0].content("a much longer text in here");
+  table.str();
+  table[0].columns().pop_back();
+
+  Table expected;
+  expected.config().width(30);
+  expected.config().autoFit(true);
+  expected.addRow({"a much longer text in here"});
+  EXPECT_EQ(table.str(), expected.str());
+}
+
+TEST(table_tests, sort)
+{
+  Table table;
+  table.addRow({"name", "size"});
+  table.addRow({"b", "\x1b[31m10\x1b[0m"});
+  table.addRow({"a", "9.5"});
+  table.addRow({"c", "n/a"});
+  table.addRow({"\x1b[1ma\x1b[0m", " 10 "});
+  table.addRow({"d"});
+
+  auto names = [&]() {
+    std::string names;
+    for (size_t i = 0; i < table.rows().size(); ++i)
+      names += string_utils::stripEscapes(table[i][0].content());
+    return names;
+  };
+
+  // the numbers ascending, the equal rows keep their order and the cells
+  // that aren't numbers go last
+  table.sort({SortKey::Numeric(1)}, 1);
+  EXPECT_EQ(names(), "nameabacd");
+
+  table.sort({SortKey::Numeric(1).descending()}, 1);
+  EXPECT_EQ(names(), "namebaacd");
+
+  // the name first, then the size
+  table.sort({SortKey::Lexical(0), SortKey::Numeric(1).descending()}, 1);
+  EXPECT_EQ(names(), "nameaabcd");
+  EXPECT_EQ(table[1][1].content(), " 10 ");
+
+  // the output follows the rows
+  EXPECT_EQ(table.str(), Table(table.rows()).str());
+}
+
+TEST(table_tests, parallel_sort)
+{
+  auto build = []() {
+    Table table;
+    for (size_t i = 0; i < 3000; ++i)
+      table.addRow({std::to_string((i * 7919) % 101), std::to_string(i % 13) + "x"});
+    return table;
+  };
+
+  const std::vector<SortKey> keys = {SortKey::Numeric(0).descending(), SortKey::Lexical(1)};
+
+  Table serial = build();
+  serial.sort(keys);
+
+  Table threaded = build();
+  threaded.config().threads(3);
+  threaded.sort(keys);
+
+  ASSERT_EQ(threaded.rows().size(), serial.rows().size());
+  for (size_t i = 0; i < serial.rows().size(); ++i)
+  {
+    EXPECT_EQ(threaded[i][0].content(), serial[i][0].content());
+    EXPECT_EQ(threaded[i][1].content(), serial[i][1].content());
+  }
+
+  // the same order as a stable sort of the rows
+  Table expected = build();
+  std::stable_sort(expected.rows().begin(), expected.rows().end(), [](const Row& a, const Row& b) {
+    const int x = std::stoi(a[0].content()), y = std::stoi(b[0].content());
+    return x != y ? y < x : a[1].content() < b[1].content();
+  });
+  EXPECT_EQ(threaded.str(), expected.str());
+}
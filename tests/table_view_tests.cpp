@@ -0,0 +1,106 @@
+#include "gtest/gtest.h"
+#include "../include/tabular/table_view.h"
+
+// to avoid repeating
+using namespace tabular;
+
+static Table makeTable()
+{
+  Table table;
+  table.config().width(40);
+  table.addRow({"3", "charlie", "a longer value that wraps in the column"});
+  table.addRow({"1", "alpha", "short"});
+  table.addRow({"4", "delta", "short"});
+  table.addRow({"2", "bravo", "another longer value"});
+  table[1][1].style().fg(Color::Red);
+  table[2].config().hasBottom(false);
+
+  return table;
+}
+
+TEST(table_view_tests, sort_and_filter)
+{
+  const Table table = makeTable();
+  TableView view(table);
+  EXPECT_EQ(view.str(), table.str());
+
+  view.sort([](const Row& a, const Row& b) { return a[0].content() < b[0].content(); });
+  EXPECT_EQ(view.indices(), std::vector<size_t>({1, 3, 0, 2}));
+  EXPECT_EQ(view[0][1].content(), "alpha");
+
+  // the same as a table with the rows in that order
+  Table sorted;
+  sorted.config().width(40);
+  for (const size_t i : view.indices())
+    sorted.addRow(table[i]);
+  EXPECT_EQ(view.str(), sorted.str());
+  EXPECT_EQ(view.str(1, 3), sorted.str(1, 3));
+
+  view.filter([](const Row& row) { return row[2].content() != "short"; });
+  EXPECT_EQ(view.indices(), std::vector<size_t>({3, 0}));
+  EXPECT_EQ(view.size(), 2);
+
+  view.reset();
+  EXPECT_EQ(view.str(), table.str());
+
+  view.filter([](const Row&) { return false; });
+  EXPECT_EQ(view.str(), "");
+}
+
+TEST(table_view_tests, table_layout)
+{
+  Table table = makeTable();
+  table.config().autoFit(true);
+  const std::string str = table.str();
+
+  // the auto-fit widths come from all the rows, not only the visible ones
+  TableView view(table);
+  view.filter([](const Row& row) { return row[2].content() == "short"; });
+
+  const std::string filtered = view.str();
+  EXPECT_EQ(filtered.substr(0, filtered.find('\n')), str.substr(0, str.find('\n')));
+
+  // the view follows the table's changes
+  table[1][1].content("changed");
+  EXPECT_NE(view.str().find("changed"), std::string::npos);
+
+  table.rows().pop_back();
+  table.rows().pop_back();
+  view.reset();
+  EXPECT_EQ(view.str(), table.str());
+
+  table.rows().pop_back();
+  EXPECT_THROW(view.str(), std::out_of_range);
+}
+
+TEST(table_view_tests, kept_references)
+{
+  Table table;
+  table.config().width(40);
+  table.config().autoFit(true);
+  table.addRow({"a", "b"});
+  table.addRow({"c", "d"});
+
+  // a row written through a reference kept from before the last render
+  TableView view(table);
+  Row& row = table[0];
+  view.str();
+  row.columns().push_back(Column("xyz"));
+  const std::string str = view.str();
+
+  Table expected(table.rows());
+  expected.config() = table.config();
+  EXPECT_EQ(str, expected.str());
+}
+
+TEST(table_view_tests, sort_keys)
+{
+  const Table table = makeTable();
+  TableView view(table);
+
+  view.sort({SortKey::Lexical(2), SortKey::Numeric(0).descending()});
+  EXPECT_EQ(view.indices(), std::vector<size_t>({0, 3, 2, 1}));
+
+  // the table isn't touched
+  EXPECT_EQ(table[0][0].content(), "3");
+}
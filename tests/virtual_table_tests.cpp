@@ -0,0 +1,85 @@
+#include "gtest/gtest.h"
+#include "../include/tabular/virtual_table.h"
+
+// to avoid repeating
+using namespace tabular;
+
+// the cells are generated from their position
+class Numbers : public Source {
+public:
+  explicit Numbers(size_t rows)
+    : rows_(rows)
+  {
+  }
+
+  size_t rows() const override { return rows_; }
+  size_t columns() const override { return 3; }
+
+  void cell(size_t row, size_t column, Column& cell) const override
+  {
+    cell.content(content(row, column));
+    if (column == 2) cell.style().fg(Color::Red);
+  }
+
+  static std::string content(size_t row, size_t column)
+  {
+    if (column == 0) return std::to_string(row);
+    if (column == 1) return "row " + std::to_string(row) + " has a long description";
+    return row % 2 ? "odd" : "even";
+  }
+
+private:
+  size_t rows_;
+};
+
+// the same cells as a regular table
+static Table materialize(size_t rows)
+{
+  Table table;
+  for (size_t i = 0; i < rows; ++i)
+  {
+    table.addRow({Numbers::content(i, 0), Numbers::content(i, 1), Numbers::content(i, 2)});
+    table[i][2].style().fg(Color::Red);
+  }
+
+  return table;
+}
+
+TEST(virtual_table_tests, same_output)
+{
+  Numbers source(20);
+  VirtualTable virt(source);
+  Table table = materialize(20);
+
+  EXPECT_EQ(virt.str(), table.str());
+  EXPECT_EQ(virt.str(5, 8), table.str(5, 8));
+  EXPECT_EQ(virt.str(20, 30), "");
+
+  // the auto-fit widths come from every cell
+  virt.config().autoFit(true);
+  table.config().autoFit(true);
+  EXPECT_EQ(virt.str(), table.str());
+  EXPECT_EQ(virt.str(18, 20), table.str(18, 20));
+
+  virt.border() = Border::Modern();
+  table.border(Border::Modern());
+  EXPECT_EQ(virt.str(), table.str());
+}
+
+TEST(virtual_table_tests, widths)
+{
+  Numbers source(3);
+  VirtualTable virt(source);
+
+  virt.config().columns({ColumnWidth::Fixed(6), ColumnWidth::Flex(), ColumnWidth::Fixed(8)});
+  std::string str = virt.str();
+  EXPECT_EQ(str.substr(0, str.find('\n')), "+" + std::string(48, '-') + "+");
+
+  // the explicit widths must match the source
+  virt.widths({10, 10});
+  EXPECT_THROW(virt.str(), std::runtime_error);
+
+  virt.widths({6, 20, 6});
+  str = virt.str();
+  EXPECT_EQ(str.substr(0, str.find('\n')), "+" + std::string(34, '-') + "+");
+}
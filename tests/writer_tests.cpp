@@ -0,0 +1,154 @@
+#include "gtest/gtest.h"
+#include "../include/tabular/writer.h"
+
+// to avoid repeating
+using namespace tabular;
+
+TEST(writer_tests, explicit_widths)
+{
+  std::string out;
+  Writer writer([&](const char* str, size_t len) { out.append(str, len); });
+  writer.widths({6, 10});
+
+  // the header and the row are written right away
+  writer.addRow({"id", "message"});
+  EXPECT_EQ(out, "+-----------------+\n| id   | message  |\n");
+
+  writer.addRow({"1", "a message that wraps"});
+  writer.close();
+
+  // the same output as a table with the same layout
+  Table table;
+  table.addRow({"id", "message"});
+  table.addRow({"1", "a message that wraps"});
+  table.config().width(19);
+  for (size_t i = 0; i < 2; ++i)
+  {
+    table[i][0].config().width(6);
+    table[i][1].config().width(10);
+  }
+
+  EXPECT_EQ(out, table.str() + '\n');
+  EXPECT_THROW(writer.addRow({"2", "closed"}), std::logic_error);
+}
+
+TEST(writer_tests, sampled_widths)
+{
+  std::string out;
+  Writer writer([&](const char* str, size_t len) { out.append(str, len); });
+  writer.config().width(30);
+  writer.sample(2);
+
+  // held back until the layout is known
+  writer.addRow({"id", "message"});
+  EXPECT_TRUE(out.empty());
+
+  writer.addRow({"1", "hello world"});
+  EXPECT_FALSE(out.empty());
+
+  // the rest of the width is shared between the columns
+  ASSERT_EQ(writer.widths().size(), 2);
+  EXPECT_EQ(writer.widths()[0], 9);
+  EXPECT_EQ(writer.widths()[1], 18);
+
+  // the layout is fixed
+  EXPECT_THROW(writer.addRow({"2", "three", "columns"}), std::runtime_error);
+
+  // the footer is written on close only
+  const size_t written = out.size();
+  writer.close();
+  EXPECT_EQ(out.substr(written), "+" + std::string(28, '-') + "+\n");
+}
+
+TEST(writer_tests, sampled_explicit_widths)
+{
+  Row first(std::vector<std::string>{"id", "message"});
+  Row second(std::vector<std::string>{"1", "hello"});
+  first[0].config().width(8);
+  second[0].config().width(5);
+
+  std::string out;
+  Writer writer([&](const char* str, size_t len) { out.append(str, len); });
+  writer.config().width(30);
+  writer.sample(2);
+  writer.addRow(first);
+  writer.addRow(second);
+  writer.close();
+
+  // the largest explicit width, as the table auto-fits them
+  Table table;
+  table.config().width(30);
+  table.config().autoFit(true);
+  table.addRow(first);
+  table.addRow(second);
+  EXPECT_EQ(writer.widths()[0], 8);
+  EXPECT_EQ(out, table.str() + '\n');
+}
+
+TEST(writer_tests, sampled_mismatch)
+{
+  std::string out;
+  {
+    Writer writer([&](const char* str, size_t len) { out.append(str, len); });
+    writer.config().width(20);
+    writer.sample(2);
+
+    // the held back rows are written once, then the writer is closed
+    writer.addRow({"a", "b"});
+    EXPECT_THROW(writer.addRow({"c", "d", "e"}), std::runtime_error);
+    EXPECT_THROW(writer.addRow({"f", "g"}), std::logic_error);
+  }
+
+  Table table;
+  table.addRow({"a", "b"});
+  table.config().width(20);
+  EXPECT_EQ(out, table.str() + '\n');
+}
+
+TEST(writer_tests, column_widths)
+{
+  std::string out;
+  Writer writer([&](const char* str, size_t len) { out.append(str, len); });
+  writer.config().width(30);
+  writer.config().columns({ColumnWidth::Fixed(5), ColumnWidth::Flex()});
+
+  // written right away, nothing is sampled
+  writer.addRow({"id", "message"});
+  EXPECT_FALSE(out.empty());
+
+  ASSERT_EQ(writer.widths().size(), 2);
+  EXPECT_EQ(writer.widths()[0], 5);
+  EXPECT_EQ(writer.widths()[1], 22);
+}
+
+TEST(writer_tests, fixed_layout)
+{
+  std::string out;
+  Writer writer([&](const char* str, size_t len) { out.append(str, len); });
+  writer.config().width(20);
+
+  // wider than the table, or narrower than a column can be
+  writer.widths({10, 10});
+  EXPECT_THROW(writer.addRow({"a", "b"}), std::runtime_error);
+  EXPECT_TRUE(out.empty());
+
+  writer.widths({1, 10});
+  EXPECT_THROW(writer.addRow({"a", "b"}), std::runtime_error);
+
+  writer.widths({7, 10});
+  writer.addRow({"a", "b"});
+  EXPECT_FALSE(out.empty());
+
+  // the layout can't change once the first row is written
+  EXPECT_THROW(writer.widths({8, 9}), std::logic_error);
+  EXPECT_EQ(writer.config().width(), 20);
+
+  // and the border changes are ignored
+  writer.config().width(40);
+  writer.border().vertical().glyph(U'#');
+  writer.border().horizontal().glyph(U'=');
+  writer.addRow({"c", "d"});
+  writer.close();
+  EXPECT_EQ(out.find('#'), std::string::npos);
+  EXPECT_EQ(out.find('='), std::string::npos);
+}